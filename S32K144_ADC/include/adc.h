@@ -22,6 +22,12 @@
 extern "C" {
 #endif
 
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* ADC0_ReadChannel_Polling() result when the conversion did not complete (not a 12-bit code) */
+#define ADC0_READ_TIMEOUT               (0xFFFFU)
+
 /*==================================================================================================
 * PUBLIC APIs
 ==================================================================================================*/
@@ -32,14 +38,15 @@ extern "C" {
  * - Configure core ADC0 registers for software-triggered conversion.
  * - Run calibration routine.
  *
+ * @return uint8_t 1: calibrated, 0: calibration timed out
  */
-void ADC0_Init(void);
+uint8_t ADC0_Init(void);
 
 /**
  * @brief Read one ADC channel using polling method.
  *
  * @param ch  ADC channel number.
- * @return uint16_t Raw ADC conversion result.
+ * @return uint16_t Raw ADC conversion result, ADC0_READ_TIMEOUT if no conversion completed.
  */
 uint16_t ADC0_ReadChannel_Polling(uint8_t ch);
 
@@ -48,7 +55,7 @@ uint16_t ADC0_ReadChannel_Polling(uint8_t ch);
  *
  * @param ch ADC channel number.
  * @param vref Reference voltage in the same unit you want returned (e.g., 5000 for mV).
- * @return float Voltage computed from raw code and vref.
+ * @return float Voltage computed from raw code and vref, -1 if the conversion timed out.
  *
  */
 float ADC0_ReadVoltage_Polling(uint8_t ch, float vref);
@@ -15,6 +15,7 @@
 #include "adc.h"
 #include "S32K144.h"
 #include "device_registers.h"
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
@@ -32,13 +33,17 @@
 /* ADC resolution: 12-bit => max code = 4095 */
 #define ADC0_MAX_CODE_12BIT              (4095.0F)
 
+/* Upper bounds of the ADC waits */
+#define ADC0_CAL_TIMEOUT_MS              (100U)
+#define ADC0_CONV_TIMEOUT_MS             (1U)
+
 /*==================================================================================================
 * LOCAL FUNCTION PROTOTYPES
 ==================================================================================================*/
 static void ADC0_ClockInit(void);
 static void ADC0_PinInit(void);
 static void ADC0_CoreConfig(void);
-static void ADC0_Calibration(void);
+static uint8_t ADC0_Calibration(void);
 
 /*==================================================================================================
 * FUNCTIONS
@@ -115,9 +120,12 @@ static void ADC0_CoreConfig(void)
 /**
  * @brief Run ADC0 calibration routine.
  *
+ * @return uint8_t 1: calibrated, 0: timeout
  */
-static void ADC0_Calibration(void)
+static uint8_t ADC0_Calibration(void)
 {
+    Time_Deadline_t deadline;
+
     /* Enable hardware average and select 32 samples to improve calibration accuracy. */
     IP_ADC0->SC3 =
         ADC_SC3_AVGE_MASK |  /* Enable averaging. */
@@ -127,37 +135,46 @@ static void ADC0_Calibration(void)
     IP_ADC0->SC3 |= ADC_SC3_CAL_MASK;
 
     /* Wait for calibration to complete (CAL bit clears when done). */
+    deadline = Time_Deadline(ADC0_CAL_TIMEOUT_MS);
     while ((IP_ADC0->SC3 & ADC_SC3_CAL_MASK) != 0U)
     {
-        /* wait */
+        if (0U != Time_Expired(deadline))
+        {
+            return 0U;
+        }
     }
 
     /* NOTE:
      * Many reference implementations also check CALF (calibration failed flag) here.
      * If CALF is set, calibration failed and results may be invalid.
      */
+    return 1U;
 }
 
 /**
  * @brief  Initialize ADC0 peripheral (clock, pin, core config, calibration).
  *
+ * @return uint8_t 1: calibrated, 0: calibration timed out
  */
-void ADC0_Init(void)
+uint8_t ADC0_Init(void)
 {
     ADC0_ClockInit();
     ADC0_PinInit();
     ADC0_CoreConfig();
-    ADC0_Calibration();
+
+    return ADC0_Calibration();
 }
 
 /**
  * @brief Read one ADC channel using polling method.
  *
  * @param ch    ADC channel number.
- * @return uint16_t Raw ADC conversion result.
+ * @return uint16_t Raw ADC conversion result, ADC0_READ_TIMEOUT if no conversion completed.
  */
 uint16_t ADC0_ReadChannel_Polling(uint8_t ch)
 {
+    Time_Deadline_t deadline;
+
     /* Write channel to SC1[0]:
      * - ADCH(ch): select input channel
      * - AIEN = 0: disable interrupt (polling mode)
@@ -166,9 +183,13 @@ uint16_t ADC0_ReadChannel_Polling(uint8_t ch)
     IP_ADC0->SC1[0] = ADC_SC1_ADCH(ch);
 
     /* Wait until conversion complete: COCO = 1. */
+    deadline = Time_Deadline(ADC0_CONV_TIMEOUT_MS);
     while ((IP_ADC0->SC1[0] & ADC_SC1_COCO_MASK) == 0U)
     {
-        /* wait */
+        if (0U != Time_Expired(deadline))
+        {
+            return ADC0_READ_TIMEOUT;
+        }
     }
 
     /* Read conversion result from result register R[0]. */
@@ -180,12 +201,17 @@ uint16_t ADC0_ReadChannel_Polling(uint8_t ch)
  *
  * @param ch ADC channel number.
  * @param vref Reference voltage in the same unit you want returned (e.g., 5000 for mV).
- * @return float Voltage computed from raw code and vref.
+ * @return float Voltage computed from raw code and vref, -1 if the conversion timed out.
  */
 float ADC0_ReadVoltage_Polling(uint8_t ch, float vref)
 {
     uint16_t raw = ADC0_ReadChannel_Polling(ch);
 
+    if (ADC0_READ_TIMEOUT == raw)
+    {
+        return -1.0F;
+    }
+
     /* 12-bit mode => full scale code = 4095.
      * voltage = raw / 4095 * vref
      */
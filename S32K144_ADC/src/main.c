@@ -16,6 +16,8 @@
 #include "device_registers.h"            /* include peripheral declarations S32K144 */
 #include "clocks_and_modes.h"
 #include "adc.h"
+#include "adc_conv.h"
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
@@ -30,16 +32,39 @@
 #define LED_ON(pin)                   do { IP_PTD->PCOR = GPIO_PIN_MASK(pin); } while (0)
 #define LED_OFF(pin)                  do { IP_PTD->PSOR = GPIO_PIN_MASK(pin); } while (0)
 
-/* Rough delay loop factor (must be calibrated if you need accurate ms). */
-#define DELAY_LOOP_PER_MS             (3000U)
+/* ADC polling / LED refresh period */
+#define ADC_POLL_PERIOD_MS            (100U)
 
-/* Voltage thresholds (unit: mV if ADC0_ReadVoltage_Polling returns mV). */
-#define VMAX_MV                       (5000.0F)
-#define THRESH_3_MV                   (3750.0F)
-#define THRESH_2_MV                   (2500.0F)
-#define THRESH_1_MV                   (1250.0F)
+/* ADC input channel (PTA6) and reference voltage in mV. */
+#define ADC_CHANNEL                   (2U)
+#define VREF_MV                       (5000U)
 
+/* Voltage thresholds in mV. */
+#define THRESH_3_MV                   (3750U)
+#define THRESH_2_MV                   (2500U)
+#define THRESH_1_MV                   (1250U)
 
+#define LED_BANDS                     (4U)
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+/* Thresholds as ADC codes, computed at compile time: no per-sample conversion. */
+static const uint16_t s_levelCodes[LED_BANDS - 1U] =
+{
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_1_MV, VREF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_2_MV, VREF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_3_MV, VREF_MV)
+};
+
+/* LED that is ON in each band: 0..1250 mV BLUE, ..2500 BLUE, ..3750 GREEN, ..5000 RED. */
+static const uint32_t s_bandLedMask[LED_BANDS] =
+{
+    GPIO_PIN_MASK(LED_BLUE),
+    GPIO_PIN_MASK(LED_BLUE),
+    GPIO_PIN_MASK(LED_GREEN),
+    GPIO_PIN_MASK(LED_RED)
+};
 
 /*==================================================================================================
 * FUNCTIONS
@@ -54,29 +79,25 @@ static void WDOG_disable(void)
     IP_WDOG->CS    = 0x00002100U;  /* Disable watchdog. */
 }
 
-static void delay_ms(uint32_t ms)
-{
-    uint32_t i = 0U;
-
-    /* Busy-wait delay: approximate only. */
-    for (i = 0U; i < (ms * DELAY_LOOP_PER_MS); i++)
-    {
-        NOP(); /* No operation. */
-    }
-}
-
 /*==================================================================================================
 * MAIN FUNCTION
 ==================================================================================================*/
 int main(void)
 {
-    float voltageMv = 0.0F;
+    uint16_t code;
+    uint32_t ledOn;
 
     WDOG_disable();
 
-    SOSC_init_8MHz();        /* Enable external 8 MHz crystal oscillator and SOSCDIV1/2. */
-    SPLL_init_160MHz();      /* Use 8 MHz source, configure PLL to 160 MHz. */
-    NormalRUNmode_80MHz();   /* Switch to RUN mode using PLL (core 80 MHz, bus 40 MHz). */
+    Time_Init();             /* SysTick time base, bounds the clock waits below. */
+
+    /* Enable external 8 MHz crystal, PLL to 160 MHz, then RUN mode from PLL (core 80 MHz, bus 40 MHz).
+     * A step that times out leaves the core on the 48 MHz FIRC.
+     */
+    if ((0U != SOSC_init_8MHz()) && (0U != SPLL_init_160MHz()))
+    {
+        (void)NormalRUNmode_80MHz();
+    }
 
     /* Enable clock gating for PORTD in PCC (Peripheral Clock Controller). */
     IP_PCC->PCCn[PCC_PORTD_INDEX] |= PCC_PCCn_CGC_MASK;
@@ -97,51 +118,26 @@ int main(void)
     LED_OFF(LED_RED);
 
     /* Initialize ADC0 (implementation is inside adc.c). */
-    ADC0_Init();
+    (void)ADC0_Init();
 
     for (;;)
     {
-        /* Read ADC channel 2 and convert to voltage (expected unit: mV).
-         * The second argument (5000) is commonly used as Vref (mV).
-         */
-        voltageMv = ADC0_ReadVoltage_Polling(2U, 5000U);
+        code  = ADC0_ReadChannel_Polling(ADC_CHANNEL);
+        ledOn = 0U;
 
-        /* Select LED based on voltage range.
-         * Use else-if to guarantee only one branch is executed.
+        /* Band from the raw code (the 12-bit code never exceeds VREF_MV).
+         * A timed out conversion turns OFF all LEDs.
          */
-        if ((voltageMv > THRESH_3_MV) && (voltageMv <= VMAX_MV))
+        if (code != ADC0_READ_TIMEOUT)
         {
-            LED_OFF(LED_GREEN);  /* Turn OFF GREEN. */
-            LED_OFF(LED_BLUE);   /* Turn OFF BLUE.  */
-            LED_ON(LED_RED);     /* Turn ON RED.    */
-        }
-        else if ((voltageMv > THRESH_2_MV) && (voltageMv <= THRESH_3_MV))
-        {
-            LED_ON(LED_GREEN);   /* Turn ON GREEN.  */
-            LED_OFF(LED_BLUE);   /* Turn OFF BLUE.  */
-            LED_OFF(LED_RED);    /* Turn OFF RED.   */
-        }
-        else if ((voltageMv > THRESH_1_MV) && (voltageMv <= THRESH_2_MV))
-        {
-            LED_OFF(LED_GREEN);  /* Turn OFF GREEN. */
-            LED_ON(LED_BLUE);    /* Turn ON BLUE.   */
-            LED_OFF(LED_RED);    /* Turn OFF RED.   */
-        }
-        else if ((voltageMv >= 0.0F) && (voltageMv <= THRESH_1_MV))
-        {
-            LED_OFF(LED_GREEN);  /* Turn OFF GREEN. */
-            LED_ON(LED_BLUE);    /* Turn ON BLUE.   */
-            LED_OFF(LED_RED);    /* Turn OFF RED.   */
-        }
-        else
-        {
-            /* Out-of-range safety: turn OFF all LEDs. */
-            LED_OFF(LED_GREEN);
-            LED_OFF(LED_BLUE);
-            LED_OFF(LED_RED);
+            ledOn = s_bandLedMask[ADC_Conv_Band(code, s_levelCodes, LED_BANDS - 1U)];
         }
 
-        delay_ms(100U); /* Rough delay to reduce LED flicker / ADC polling rate. */
+        /* Active-low: set the others first, then clear the selected one. */
+        IP_PTD->PSOR = (GPIO_PIN_MASK(LED_RED) | GPIO_PIN_MASK(LED_GREEN) | GPIO_PIN_MASK(LED_BLUE)) & ~ledOn;
+        IP_PTD->PCOR = ledOn;
+
+        Delay_ms(ADC_POLL_PERIOD_MS); /* Reduce LED flicker / ADC polling rate. */
     }
 
     return 0;
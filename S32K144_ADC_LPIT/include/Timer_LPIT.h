@@ -23,6 +23,12 @@
 extern "C" {
 #endif
 
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* Upper bound of LPIT0_InitTrigger(): one ADC0 conversion (about 8 us) per trigger */
+#define LPIT0_TRIGGER_MAX_HZ    (100000U)
+
 /*==================================================================================================
 * FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -33,6 +39,17 @@ extern "C" {
  */
 void LPIT0_Init(void);
 
+/**
+ * @brief Initialize LPIT0 Channel 0 as a periodic hardware trigger, no interrupt.
+ *
+ * The channel 0 trigger output goes to TRGMUX (source LPIT_CH0), e.g. to start
+ * PDB0. The sampling instant does not depend on interrupt latency.
+ *
+ * @param rate_hz Trigger rate in Hz (1..LPIT0_TRIGGER_MAX_HZ)
+ * @return uint8_t 1: started, 0: rate out of range
+ */
+uint8_t LPIT0_InitTrigger(uint32_t rate_hz);
+
 /**
  * @brief Start LPIT0 Channel 0 timer.
  *
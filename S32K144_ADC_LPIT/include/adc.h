@@ -39,8 +39,9 @@ extern volatile uint32_t g_adcNew;
  * - Run calibration routine.
 
  *
+ * @return uint8_t 1: calibrated, 0: calibration timed out
  */
-void ADC0_Init(void);
+uint8_t ADC0_Init(void);
 
 /**
  * @brief Start one conversion by software trigger. Call this from LPIT0_Ch0_IRQHandler().
@@ -48,6 +49,33 @@ void ADC0_Init(void);
  */
 void ADC0_StartConversion_SwTrigger(void);
 
+/**
+ * @brief Switch ADC0 to hardware trigger (ADC_SC2_ADTRG). Call after ADC0_Init().
+ *
+ * Conversions of SC1[0] are then started by PDB0 pretrigger 0, see PDB0_Init().
+ * ADC0_IRQHandler() still publishes each result in g_adcResult/g_adcNew.
+ *
+ */
+void ADC0_EnableHwTrigger(void);
+
+/**
+ * @brief Arm the ADC0 hardware compare: a conversion only completes (COCO, interrupt,
+ * DMA request) when its result is below low or above high.
+ *
+ * Results inside the range are dropped by the ADC, so a steady input never wakes
+ * the core. Re-arm with the new range after each crossing.
+ *
+ * @param low Lowest code of the quiet range (CV1)
+ * @param high Highest code of the quiet range (CV2), low <= high
+ */
+void ADC0_SetCompareRange(uint16_t low, uint16_t high);
+
+/**
+ * @brief Disable the ADC0 hardware compare: every conversion completes again.
+ *
+ */
+void ADC0_DisableCompare(void);
+
 #ifdef __cplusplus
 }
 #endif
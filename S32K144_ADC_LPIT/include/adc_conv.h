@@ -0,0 +1,81 @@
+/**
+ * @file adc_conv.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Fixed-point ADC code conversion and threshold bands for S32K144
+ * @version 0.1
+ * @date 2026-03-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ADC_CONV_H_
+#define ADC_CONV_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* 12-bit full scale code */
+#define ADC_CONV_MAX_CODE                 (4095U)
+
+/* mV per code in Q16 (rounded), ref_mv < 65536 */
+#define ADC_CONV_MV_PER_CODE_Q16(ref_mv)  \
+    (((((uint32_t)(ref_mv)) << 16U) + (ADC_CONV_MAX_CODE / 2U)) / ADC_CONV_MAX_CODE)
+
+/* First code whose voltage is above mv, i.e. code * ref_mv > mv * 4095 (exact).
+ * Matches "(code / 4095.0f) * ref > mv" except where code * ref_mv == mv * 4095 and the
+ * float result rounds up (none for the 5000 mV demo thresholds; S32K144_ADC_LPIT/tools/adc_conv_check.c). */
+#define ADC_CONV_CODE_ABOVE(mv, ref_mv)   \
+    (((((uint32_t)(mv)) * ADC_CONV_MAX_CODE) / (uint32_t)(ref_mv)) + 1U)
+
+/*==================================================================================================
+* PUBLIC APIs
+==================================================================================================*/
+/**
+ * @brief Convert a raw ADC code to millivolts.
+ *
+ * @param code Raw 12-bit ADC code
+ * @param mvPerCodeQ16 Scale from ADC_CONV_MV_PER_CODE_Q16()
+ * @return uint32_t Voltage in mV (rounded)
+ */
+uint32_t ADC_Conv_ToMv(uint16_t code, uint32_t mvPerCodeQ16);
+
+/**
+ * @brief Classify a raw ADC code against ascending threshold codes.
+ *
+ * No float math and no compare chain: the band is the number of levels the code
+ * reaches, so it can index a table directly.
+ *
+ * @param code Raw 12-bit ADC code
+ * @param levels Ascending codes from ADC_CONV_CODE_ABOVE()
+ * @param count Number of levels
+ * @return uint32_t Band 0..count (0: below levels[0])
+ */
+uint32_t ADC_Conv_Band(uint16_t code, const uint16_t *levels, uint32_t count);
+
+/**
+ * @brief Code range [low, high] of a band, e.g. for the ADC hardware compare.
+ *
+ * @param band Band 0..count from ADC_Conv_Band()
+ * @param levels Ascending codes from ADC_CONV_CODE_ABOVE()
+ * @param count Number of levels
+ * @param low Output: first code of the band
+ * @param high Output: last code of the band
+ */
+void ADC_Conv_BandRange(uint32_t band, const uint16_t *levels, uint32_t count,
+                        uint16_t *low, uint16_t *high);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_CONV_H_ */
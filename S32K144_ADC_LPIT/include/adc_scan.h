@@ -0,0 +1,76 @@
+/**
+ * @file adc_scan.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief ADC0 multi-channel scan with eDMA ping-pong buffer for S32K144
+ * @version 0.1
+ * @date 2026-03-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* Channels per sequence: 1, 2 or 4 (eDMA source modulo over the R[] window) */
+#define ADC_SCAN_MAX_CHANNELS        (4U)
+
+/* Sequences per half buffer (one callback per block) */
+#define ADC_SCAN_BLOCK_SEQUENCES     (32U)
+
+/*==================================================================================================
+* TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief Block complete callback, called from DMA0_IRQHandler().
+ *
+ * block[s * count + n] is the result of channel n in sequence s. The block stays
+ * valid until the DMA comes back to it, i.e. for one block period. It is word
+ * aligned, so channel pairs can be read as packed uint32_t (see dsp_filter.h).
+ *
+ * @param block Completed half buffer
+ * @param sequences Number of sequences in the block (ADC_SCAN_BLOCK_SEQUENCES)
+ */
+typedef void (*ADC0_ScanCallback_t)(const uint16_t *block, uint32_t sequences);
+
+/*==================================================================================================
+* FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief Start the ADC0 scan: PDB0 pretriggers convert the channels back-to-back on
+ * each LPIT0 CH0 trigger, eDMA CH0 moves every result into the ping-pong buffer.
+ *
+ * Call after ADC0_Init(), then start the trigger with LPIT0_InitTrigger().
+ * The input pins must already be analog (PCR MUX = 0).
+ *
+ * @param channels ADC0 input channels (ADCH) in conversion order
+ * @param count Number of channels: 1, 2 or 4
+ * @param callback Block complete callback
+ * @return uint8_t 1: started, 0: invalid parameter
+ */
+uint8_t ADC0_Scan_Init(const uint8_t *channels, uint8_t count, ADC0_ScanCallback_t callback);
+
+/**
+ * @brief Number of blocks completed since ADC0_Scan_Init().
+ *
+ * @return uint32_t Block count
+ */
+uint32_t ADC0_Scan_GetBlockCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_SCAN_H_ */
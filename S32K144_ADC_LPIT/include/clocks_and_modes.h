@@ -26,20 +26,23 @@ extern "C" {
 /**
  * @brief Initialize System Oscillator (SOSC) to use 8 MHz external crystal.
  *
+ * @return uint8_t 1: SOSC valid, 0: timeout (no crystal)
  */
-void SOSC_init_8MHz(void);
+uint8_t SOSC_init_8MHz(void);
 
 /**
  * @brief Initialize System PLL (SPLL) to generate 160 MHz system clock.
  *
+ * @return uint8_t 1: SPLL locked, 0: timeout
  */
-void SPLL_init_160MHz(void);
+uint8_t SPLL_init_160MHz(void);
 
 /**
  * @brief Switch to Normal RUN mode with 80 MHz core clock using SPLL.
  *
+ * @return uint8_t 1: running from SPLL, 0: timeout (clock not switched)
  */
-void NormalRUNmode_80MHz(void);
+uint8_t NormalRUNmode_80MHz(void);
 
 #ifdef __cplusplus
 }
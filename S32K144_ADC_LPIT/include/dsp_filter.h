@@ -0,0 +1,210 @@
+/**
+ * @file dsp_filter.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Filters for ADC sample blocks (two channels per packed 32-bit word)
+ * @version 0.1
+ * @date 2026-03-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DSP_FILTER_H_
+#define DSP_FILTER_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* Cycle count per Process call (DWT CYCCNT); on the target by default */
+#ifndef DSP_FILTER_BENCH
+#if defined(__arm__)
+#define DSP_FILTER_BENCH             (1U)
+#else
+#define DSP_FILTER_BENCH             (0U)
+#endif
+#endif
+
+#define DSP_MAVG_MAX_LEN             (32U)   /* Moving average window, power of two */
+#define DSP_MEDIAN_MAX_N             (7U)    /* Median window, odd */
+#define DSP_CIC_MAX_DECIMATION       (64U)   /* CIC rate change, power of two */
+
+/* IIR smoothing factor (Q15): y += alpha * (x - y) */
+#define DSP_IIR_ALPHA_Q15(a)         ((uint16_t)((a) * 32768.0F))
+
+/*==================================================================================================
+* TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief Cycles spent in a filter and the number of input words it processed
+ */
+typedef struct
+{
+    uint32_t cycles;
+    uint32_t samples;
+} DSP_Bench_t;
+
+/**
+ * @brief Moving average over len samples, both lanes
+ */
+typedef struct
+{
+    uint32_t    ring[DSP_MAVG_MAX_LEN];  /* Last len inputs (packed) */
+    int32_t     sum0;
+    int32_t     sum1;
+    uint32_t    len;
+    uint32_t    shift;                   /* log2(len) */
+    uint32_t    pos;
+    uint8_t     primed;
+    DSP_Bench_t bench;
+} DSP_MovAvg_t;
+
+/**
+ * @brief Single-pole IIR low pass, both lanes
+ */
+typedef struct
+{
+    uint32_t    coef;                    /* Packed Q15 (alpha, 1 - alpha) */
+    uint32_t    y0;                      /* Lane state, sample << 3 */
+    uint32_t    y1;
+    uint32_t    r0;                      /* Q15 remainder of the last update, per lane */
+    uint32_t    r1;
+    uint8_t     primed;
+    DSP_Bench_t bench;
+} DSP_Iir_t;
+
+/**
+ * @brief Second order CIC decimator, both lanes
+ */
+typedef struct
+{
+    uint32_t    integ[2][2];             /* [stage][lane], wrap-around arithmetic */
+    uint32_t    comb[2][2];              /* Previous comb inputs */
+    uint32_t    rate;
+    uint32_t    shift;                   /* 2 * log2(rate): CIC gain */
+    uint32_t    phase;
+    DSP_Bench_t bench;
+} DSP_Cic_t;
+
+/**
+ * @brief Median of the last n samples, both lanes
+ */
+typedef struct
+{
+    uint32_t    ring[DSP_MEDIAN_MAX_N];
+    uint32_t    n;
+    uint32_t    pos;
+    uint8_t     primed;
+    DSP_Bench_t bench;
+} DSP_Median_t;
+
+/*==================================================================================================
+* FUNCTION PROTOTYPES
+==================================================================================================*/
+/* Blocks hold one 32-bit word per sample pair: lane 0 (low half) and lane 1 (high half),
+ * e.g. a two channel ADC0 scan block read as uint32_t. `stride` is the distance in words
+ * between two inputs of the same pair (2 for a four channel scan). Outputs are packed
+ * and contiguous. */
+
+/**
+ * @brief Initialize a moving average. The first input fills the window.
+ *
+ * @param f Filter
+ * @param len Window length, power of two (1..DSP_MAVG_MAX_LEN)
+ * @return uint8_t 1: ok, 0: invalid length
+ */
+uint8_t DSP_MovAvg_Init(DSP_MovAvg_t *f, uint32_t len);
+
+/**
+ * @brief Filter n inputs.
+ *
+ * @param f Filter
+ * @param in Input words
+ * @param stride Word step between inputs
+ * @param n Number of inputs
+ * @param out n output words
+ */
+void DSP_MovAvg_Process(DSP_MovAvg_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out);
+
+/**
+ * @brief Initialize a single-pole IIR. The first input sets the state.
+ *
+ * @param f Filter
+ * @param alphaQ15 Smoothing factor from DSP_IIR_ALPHA_Q15(), 1..32767
+ * @return uint8_t 1: ok, 0: invalid factor
+ */
+uint8_t DSP_Iir_Init(DSP_Iir_t *f, uint16_t alphaQ15);
+
+/**
+ * @brief Filter n inputs.
+ *
+ * @param f Filter
+ * @param in Input words
+ * @param stride Word step between inputs
+ * @param n Number of inputs
+ * @param out n output words
+ */
+void DSP_Iir_Process(DSP_Iir_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out);
+
+/**
+ * @brief Initialize a CIC decimator.
+ *
+ * @param f Filter
+ * @param rate Decimation, power of two (2..DSP_CIC_MAX_DECIMATION)
+ * @return uint8_t 1: ok, 0: invalid rate
+ */
+uint8_t DSP_Cic_Init(DSP_Cic_t *f, uint32_t rate);
+
+/**
+ * @brief Filter n inputs.
+ *
+ * @param f Filter
+ * @param in Input words
+ * @param stride Word step between inputs
+ * @param n Number of inputs
+ * @param out Output words, at least n / rate + 1
+ * @return uint32_t Number of outputs written
+ */
+uint32_t DSP_Cic_Process(DSP_Cic_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out);
+
+/**
+ * @brief Initialize a median filter. The first input fills the window.
+ *
+ * @param f Filter
+ * @param n Window, odd (3..DSP_MEDIAN_MAX_N)
+ * @return uint8_t 1: ok, 0: invalid window
+ */
+uint8_t DSP_Median_Init(DSP_Median_t *f, uint32_t n);
+
+/**
+ * @brief Filter n inputs.
+ *
+ * @param f Filter
+ * @param in Input words
+ * @param stride Word step between inputs
+ * @param n Number of inputs
+ * @param out n output words
+ */
+void DSP_Median_Process(DSP_Median_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out);
+
+/**
+ * @brief Average cycles per input word (sample pair) of a filter.
+ *
+ * @param bench Bench counters of a filter
+ * @return uint32_t Cycles per input, 0 before the first Process call or without DSP_FILTER_BENCH
+ */
+uint32_t DSP_Bench_CyclesPerSample(const DSP_Bench_t *bench);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_FILTER_H_ */
@@ -0,0 +1,144 @@
+/**
+ * @file dsp_simd.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Cortex-M4 DSP (SIMD) instructions on packed 16-bit lanes, with C fallback
+ * @version 0.1
+ * @date 2026-03-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DSP_SIMD_H_
+#define DSP_SIMD_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* 1: ARMv7E-M DSP instructions (S32K144), 0: portable C, e.g. on a host */
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_SIMD_HW                 (1U)
+#else
+#define DSP_SIMD_HW                 (0U)
+#endif
+
+/* Lane access: lane 0 is the low halfword (first channel of a scan pair) */
+#define DSP_LANE0(x)                ((uint32_t)(x) & 0xFFFFUL)
+#define DSP_LANE1(x)                ((uint32_t)(x) >> 16U)
+#define DSP_PACK(lane0, lane1)      (((uint32_t)(lane0) & 0xFFFFUL) | ((uint32_t)(lane1) << 16U))
+
+/*==================================================================================================
+* INLINE FUNCTIONS
+==================================================================================================*/
+/* Same operations as the CMSIS __SADD16/__SSUB16/__SMLAD/__USAT intrinsics; the
+ * CMSIS core headers are not part of this project. */
+
+/**
+ * @brief Lane-wise signed 16-bit add (SADD16).
+ */
+static inline uint32_t DSP_SADD16(uint32_t a, uint32_t b)
+{
+#if (DSP_SIMD_HW == 1U)
+    uint32_t r;
+    __asm ("sadd16 %0, %1, %2" : "=r" (r) : "r" (a), "r" (b) : "cc");
+    return r;
+#else
+    return DSP_PACK((int16_t)a + (int16_t)b, (int16_t)(a >> 16U) + (int16_t)(b >> 16U));
+#endif
+}
+
+/**
+ * @brief Lane-wise signed 16-bit subtract (SSUB16).
+ */
+static inline uint32_t DSP_SSUB16(uint32_t a, uint32_t b)
+{
+#if (DSP_SIMD_HW == 1U)
+    uint32_t r;
+    __asm ("ssub16 %0, %1, %2" : "=r" (r) : "r" (a), "r" (b) : "cc");
+    return r;
+#else
+    return DSP_PACK((int16_t)a - (int16_t)b, (int16_t)(a >> 16U) - (int16_t)(b >> 16U));
+#endif
+}
+
+/**
+ * @brief Dual signed 16x16 multiply with 32-bit accumulate (SMLAD):
+ * acc + a.lo * b.lo + a.hi * b.hi
+ */
+static inline int32_t DSP_SMLAD(uint32_t a, uint32_t b, int32_t acc)
+{
+#if (DSP_SIMD_HW == 1U)
+    int32_t r;
+    __asm ("smlad %0, %1, %2, %3" : "=r" (r) : "r" (a), "r" (b), "r" (acc));
+    return r;
+#else
+    return acc + ((int32_t)(int16_t)a * (int16_t)b) +
+           ((int32_t)(int16_t)(a >> 16U) * (int16_t)(b >> 16U));
+#endif
+}
+
+/**
+ * @brief Unsigned saturate to 12 bits, i.e. the ADC code range (USAT #12).
+ */
+static inline uint32_t DSP_USAT12(int32_t x)
+{
+#if (DSP_SIMD_HW == 1U)
+    uint32_t r;
+    __asm ("usat %0, #12, %1" : "=r" (r) : "r" (x) : "cc");
+    return r;
+#else
+    return (x < 0) ? 0U : ((x > 4095) ? 4095U : (uint32_t)x);
+#endif
+}
+
+/**
+ * @brief Lane-wise unsigned 16-bit minimum (USUB16 sets GE, SEL picks).
+ */
+static inline uint32_t DSP_UMIN16(uint32_t a, uint32_t b)
+{
+#if (DSP_SIMD_HW == 1U)
+    uint32_t r;
+    uint32_t t;
+    /* One asm block: nothing may touch the GE flags between USUB16 and SEL */
+    __asm ("usub16 %1, %2, %3\n\t"
+           "sel %0, %3, %2"
+           : "=r" (r), "=&r" (t) : "r" (a), "r" (b) : "cc");
+    return r;
+#else
+    return DSP_PACK((DSP_LANE0(a) < DSP_LANE0(b)) ? DSP_LANE0(a) : DSP_LANE0(b),
+                    (DSP_LANE1(a) < DSP_LANE1(b)) ? DSP_LANE1(a) : DSP_LANE1(b));
+#endif
+}
+
+/**
+ * @brief Lane-wise unsigned 16-bit maximum (USUB16 sets GE, SEL picks).
+ */
+static inline uint32_t DSP_UMAX16(uint32_t a, uint32_t b)
+{
+#if (DSP_SIMD_HW == 1U)
+    uint32_t r;
+    uint32_t t;
+    __asm ("usub16 %1, %2, %3\n\t"
+           "sel %0, %2, %3"
+           : "=r" (r), "=&r" (t) : "r" (a), "r" (b) : "cc");
+    return r;
+#else
+    return DSP_PACK((DSP_LANE0(a) >= DSP_LANE0(b)) ? DSP_LANE0(a) : DSP_LANE0(b),
+                    (DSP_LANE1(a) >= DSP_LANE1(b)) ? DSP_LANE1(a) : DSP_LANE1(b));
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_SIMD_H_ */
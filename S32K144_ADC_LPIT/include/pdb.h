@@ -0,0 +1,64 @@
+/**
+ * @file pdb.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief PDB0 hardware trigger driver for ADC0 on S32K144
+ * @version 0.1
+ * @date 2026-03-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef PDB_H_
+#define PDB_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* TRGMUX input that starts PDB0 (S32K1xx TRGMUX source table) */
+#define PDB0_TRGMUX_SRC_LPIT0_CH0   (0x11U)
+
+/* PDB0 channel 0 pretriggers drive ADC0 SC1[0..7] */
+#define PDB0_MAX_PRETRIGGERS        (8U)
+
+/*==================================================================================================
+* FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief Route a TRGMUX source to PDB0 and enable ADC0 pretriggers.
+ *
+ * Each trigger starts one sequence: pretrigger `first` fires right away, the next
+ * ones run back-to-back on the previous conversion complete, so
+ * SC1[first..first+count-1] are converted in order without CPU help.
+ *
+ * @param trgmuxSource TRGMUX source of the trigger (PDB0_TRGMUX_SRC_*)
+ * @param first First ADC0 pretrigger / SC1 index
+ * @param count Number of pretriggers (first + count <= PDB0_MAX_PRETRIGGERS)
+ * @return uint8_t 1: configured, 0: invalid pretrigger range
+ */
+uint8_t PDB0_Init(uint8_t trgmuxSource, uint8_t first, uint8_t count);
+
+/**
+ * @brief Read and clear the ADC0 pretrigger sequence errors.
+ *
+ * A bit is set when a pretrigger fired before the result of its previous
+ * conversion was read, i.e. a sample was lost.
+ *
+ * @return uint8_t Error flag of each pretrigger, 0: no sample lost
+ */
+uint8_t PDB0_GetSequenceErrors(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDB_H_ */
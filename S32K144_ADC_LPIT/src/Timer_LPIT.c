@@ -21,7 +21,7 @@
 ==================================================================================================*/
 static void LPIT0_ClockInit(void);
 static void LPIT0_ModuleInit(void);
-static void LPIT0_Ch0_Init_1ms(void);
+static void LPIT0_Ch0_Init(uint32_t period_hz, uint8_t irqEnable);
 static void LPIT0_Ch0_IrqEnable(void);
 
 /*==================================================================================================
@@ -87,14 +87,19 @@ static void LPIT0_ModuleInit(void)
 }
 
 /**
- * @brief Initialize LPIT0 Channel 0 for 1 ms periodic interrupts.
+ * @brief Initialize LPIT0 Channel 0 for a periodic timeout.
  *
+ * The channel trigger output pulses on every timeout whether or not the
+ * interrupt is enabled.
+ *
+ * @param period_hz Timeout rate in Hz
+ * @param irqEnable 1: enable the timeout interrupt inside LPIT
  */
-static void LPIT0_Ch0_Init_1ms(void)
+static void LPIT0_Ch0_Init(uint32_t period_hz, uint8_t irqEnable)
 {
     uint32_t timerTicks;
 
-    timerTicks = (LPIT0_CLK_HZ / LPIT0_CH0_PERIOD_HZ) - 1U;
+    timerTicks = (LPIT0_CLK_HZ / period_hz) - 1U;
 
     /* Disable channel before configuring */
     IP_LPIT0->TMR[0].TCTRL = 0U;
@@ -105,8 +110,15 @@ static void LPIT0_Ch0_Init_1ms(void)
     /* Load timeout value */
     IP_LPIT0->TMR[0].TVAL = timerTicks;
 
-    /* Enable interrupt generation for channel 0 inside LPIT */
-    IP_LPIT0->MIER |= LPIT_MIER_TIE0_MASK;
+    /* Interrupt generation for channel 0 inside LPIT */
+    if (irqEnable != 0U)
+    {
+        IP_LPIT0->MIER |= LPIT_MIER_TIE0_MASK;
+    }
+    else
+    {
+        IP_LPIT0->MIER &= ~LPIT_MIER_TIE0_MASK;
+    }
 
     /* Enable channel 0 */
     IP_LPIT0->TMR[0].TCTRL |= LPIT_TMR_TCTRL_T_EN_MASK;
@@ -145,7 +157,28 @@ void LPIT0_Init(void)
     LPIT0_ClockInit();
     LPIT0_ModuleInit();
     LPIT0_Ch0_IrqEnable();
-    LPIT0_Ch0_Init_1ms();
+    LPIT0_Ch0_Init(LPIT0_CH0_PERIOD_HZ, 1U);
+}
+
+/**
+ * @brief Initialize LPIT0 Channel 0 as a periodic hardware trigger (TRGMUX), no interrupt.
+ *
+ * @param rate_hz Trigger rate in Hz (1..LPIT0_TRIGGER_MAX_HZ)
+ * @return uint8_t 1: started, 0: rate out of range
+ */
+uint8_t LPIT0_InitTrigger(uint32_t rate_hz)
+{
+    uint8_t result = 0U;
+
+    if ((rate_hz != 0U) && (rate_hz <= LPIT0_TRIGGER_MAX_HZ))
+    {
+        LPIT0_ClockInit();
+        LPIT0_ModuleInit();
+        LPIT0_Ch0_Init(rate_hz, 0U);
+        result = 1U;
+    }
+
+    return result;
 }
 
 /**
@@ -15,6 +15,7 @@
 #include "adc.h"
 #include "device_registers.h"
 #include "S32K144.h"
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
@@ -23,6 +24,7 @@
 #define ADC0_CHANNEL_SE          (2U)   /* Your design: PTA6 -> ADC0 channel 2 */
 #define ADC0_IRQ_PRIORITY        (10U)  /* Priority level: 0..15 (implemented in MSBs) */
 #define NVIC_PRIO_BITS           (4U)   /* S32K144: 16 priority levels */
+#define ADC0_CAL_TIMEOUT_MS      (100U) /* Upper bound of the calibration wait */
 
 /*==================================================================================================
 * GLOBAL VARIABLES
@@ -41,7 +43,7 @@ static uint8_t s_adcChannel = (uint8_t)ADC0_CHANNEL_SE;
 static void ADC0_ClockInit(void);
 static void ADC0_PinInit(void);
 static void ADC0_CoreConfig_SwTrigger(void);
-static void ADC0_Calibration(void);
+static uint8_t ADC0_Calibration(void);
 static void ADC0_IrqEnable(void);
 
 /*==================================================================================================
@@ -120,22 +122,33 @@ static void ADC0_CoreConfig_SwTrigger(void)
 /**
  * @brief Run ADC0 calibration routine.
  *
+ * @return uint8_t 1: calibrated, 0: timeout
  */
-static void ADC0_Calibration(void)
+static uint8_t ADC0_Calibration(void)
 {
+    uint8_t         result   = 1U;
+    Time_Deadline_t deadline;
+
     /* Enable HW average 32 samples during calibration */
     IP_ADC0->SC3 = ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(3U);
 
     /* Start calibration */
     IP_ADC0->SC3 |= ADC_SC3_CAL_MASK;
 
+    deadline = Time_Deadline(ADC0_CAL_TIMEOUT_MS);
     while ((IP_ADC0->SC3 & ADC_SC3_CAL_MASK) != 0U)
     {
-        /* wait */
+        if (0U != Time_Expired(deadline))
+        {
+            result = 0U;
+            break;
+        }
     }
 
     /* Disable average after calibration for faster runtime conversions */
     IP_ADC0->SC3 = 0U;
+
+    return result;
 }
 
 /**
@@ -172,6 +185,41 @@ void ADC0_StartConversion_SwTrigger(void)
     IP_ADC0->SC1[0] = ADC_SC1_ADCH((uint32_t)s_adcChannel) | ADC_SC1_AIEN_MASK;
 }
 
+/**
+ * @brief Switch ADC0 to hardware trigger (PDB0 pretrigger 0 -> SC1[0]).
+ *
+ */
+void ADC0_EnableHwTrigger(void)
+{
+    /* Select the trigger first: with ADTRG = 0 the SC1[0] write below would start a conversion */
+    IP_ADC0->SC2 |= ADC_SC2_ADTRG_MASK;
+
+    /* Channel and COCO interrupt for every pretrigger conversion */
+    IP_ADC0->SC1[0] = ADC_SC1_ADCH((uint32_t)s_adcChannel) | ADC_SC1_AIEN_MASK;
+}
+
+/**
+ * @brief Only complete (and interrupt) on results outside [low, high].
+ *
+ */
+void ADC0_SetCompareRange(uint16_t low, uint16_t high)
+{
+    IP_ADC0->CV[0] = ADC_CV_CV((uint32_t)low);
+    IP_ADC0->CV[1] = ADC_CV_CV((uint32_t)high);
+
+    /* ACFGT = 0, ACREN = 1, CV1 <= CV2: outside range, not inclusive (result < CV1 or > CV2) */
+    IP_ADC0->SC2 = (IP_ADC0->SC2 & ~ADC_SC2_ACFGT_MASK) | ADC_SC2_ACFE_MASK | ADC_SC2_ACREN_MASK;
+}
+
+/**
+ * @brief Disable the hardware compare: every conversion completes again.
+ *
+ */
+void ADC0_DisableCompare(void)
+{
+    IP_ADC0->SC2 &= ~(ADC_SC2_ACFE_MASK | ADC_SC2_ACFGT_MASK | ADC_SC2_ACREN_MASK);
+}
+
 /**
  * @brief Initialize ADC0 peripheral:
  * - Enable clock for ADC0 and its input port.
@@ -179,17 +227,22 @@ void ADC0_StartConversion_SwTrigger(void)
  * - Configure core ADC0 registers for software-triggered conversion.
  * - Run calibration routine.
  *
+ * @return uint8_t 1: calibrated, 0: calibration timed out
  */
-void ADC0_Init(void)
+uint8_t ADC0_Init(void)
 {
+    uint8_t calibrated;
+
     ADC0_ClockInit();
     ADC0_PinInit();
     ADC0_CoreConfig_SwTrigger();
-    ADC0_Calibration();
+    calibrated = ADC0_Calibration();
     ADC0_IrqEnable();
 
     /* Ensure channel selection is set for runtime starts */
     s_adcChannel = (uint8_t)ADC0_CHANNEL_SE;
 
     /* Do not start conversion here; LPIT IRQ will call ADC0_StartConversion_SwTrigger(). */
+
+    return calibrated;
 }
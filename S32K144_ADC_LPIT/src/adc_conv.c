@@ -0,0 +1,76 @@
+/**
+ * @file adc_conv.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Fixed-point ADC code conversion and threshold bands for S32K144
+ * @version 0.1
+ * @date 2026-03-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include "adc_conv.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define ADC_CONV_Q16_HALF        (0x8000UL)
+#define ADC_CONV_Q16_SHIFT       (16U)
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief Convert a raw ADC code to millivolts.
+ *
+ * @param code Raw 12-bit ADC code
+ * @param mvPerCodeQ16 Scale from ADC_CONV_MV_PER_CODE_Q16()
+ * @return uint32_t Voltage in mV (rounded)
+ */
+uint32_t ADC_Conv_ToMv(uint16_t code, uint32_t mvPerCodeQ16)
+{
+    /* One multiply and a shift: no int-to-float, no divide */
+    return (((uint32_t)code * mvPerCodeQ16) + ADC_CONV_Q16_HALF) >> ADC_CONV_Q16_SHIFT;
+}
+
+/**
+ * @brief Classify a raw ADC code against ascending threshold codes.
+ *
+ * @param code Raw 12-bit ADC code
+ * @param levels Ascending codes from ADC_CONV_CODE_ABOVE()
+ * @param count Number of levels
+ * @return uint32_t Band 0..count (0: below levels[0])
+ */
+uint32_t ADC_Conv_Band(uint16_t code, const uint16_t *levels, uint32_t count)
+{
+    uint32_t band = 0U;
+    uint32_t i;
+
+    /* Each compare adds 0 or 1 (conditional set, no branch on the sample) */
+    for (i = 0U; i < count; i++)
+    {
+        band += (code >= levels[i]) ? 1U : 0U;
+    }
+
+    return band;
+}
+
+/**
+ * @brief Code range [low, high] of a band.
+ *
+ * @param band Band 0..count from ADC_Conv_Band()
+ * @param levels Ascending codes from ADC_CONV_CODE_ABOVE()
+ * @param count Number of levels
+ * @param low Output: first code of the band
+ * @param high Output: last code of the band
+ */
+void ADC_Conv_BandRange(uint32_t band, const uint16_t *levels, uint32_t count,
+                        uint16_t *low, uint16_t *high)
+{
+    *low  = (band == 0U) ? 0U : levels[band - 1U];
+    *high = (band >= count) ? (uint16_t)ADC_CONV_MAX_CODE : (uint16_t)(levels[band] - 1U);
+}
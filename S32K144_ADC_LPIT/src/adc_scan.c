@@ -0,0 +1,222 @@
+/**
+ * @file adc_scan.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief ADC0 multi-channel scan with eDMA ping-pong buffer for S32K144
+ * @version 0.1
+ * @date 2026-03-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stddef.h>
+#include "adc_scan.h"
+#include "pdb.h"
+#include "NVIC.h"
+#include "device_registers.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define ADC_SCAN_DMA_CH              (0U)
+#define ADC_SCAN_DMAMUX_SRC_ADC0     (42U)  /* DMAMUX request source: ADC0 COCO */
+#define ADC_SCAN_IRQ_PRIORITY        (10U)  /* Priority level: 0..15 (implemented in MSBs) */
+#define NVIC_PRIO_BITS               (4U)   /* S32K144: 16 priority levels */
+
+#define ADC_SCAN_DMA_SIZE_16BIT      (1U)   /* TCD ATTR SSIZE/DSIZE */
+#define ADC_SCAN_RESULT_BYTES        (2U)
+#define ADC_SCAN_R_STRIDE            (4U)   /* R[n] register step */
+
+#define ADC_SCAN_BUFFER_SIZE         (2U * ADC_SCAN_BLOCK_SEQUENCES * ADC_SCAN_MAX_CHANNELS)
+
+/*==================================================================================================
+* STATIC VARIABLES
+==================================================================================================*/
+/* Word aligned: two channel blocks can be read as packed pairs (dsp_filter) */
+ALIGNED(4) static uint16_t          s_scanBuffer[ADC_SCAN_BUFFER_SIZE];
+static uint32_t                     s_scanBlockLen;     /* Results per half buffer */
+static ADC0_ScanCallback_t          s_scanCallback;
+static volatile uint32_t            s_scanBlockCount;
+
+/*==================================================================================================
+* STATIC FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint8_t ADC0_Scan_FirstIndex(uint8_t count);
+static void ADC0_Scan_DmaInit(uint8_t first, uint8_t count);
+static void ADC0_Scan_IrqEnable(void);
+
+/*==================================================================================================
+* INTERRUPT HANDLER
+==================================================================================================*/
+
+/**
+ * @brief eDMA channel 0 interrupt: half or full major loop, i.e. one block done
+ *
+ */
+void DMA0_IRQHandler(void)
+{
+    const uint16_t *block;
+
+    IP_DMA->CINT = DMA_CINT_CINT(ADC_SCAN_DMA_CH);
+
+    /* CITER reloads to BITER at the end of the major loop: while the DMA fills the
+     * first half again the second half is complete, and the other way round */
+    if ((uint32_t)IP_DMA->TCD[ADC_SCAN_DMA_CH].CITER.ELINKNO > s_scanBlockLen)
+    {
+        block = &s_scanBuffer[s_scanBlockLen];
+    }
+    else
+    {
+        block = &s_scanBuffer[0];
+    }
+
+    s_scanBlockCount++;
+
+    if (s_scanCallback != NULL)
+    {
+        s_scanCallback(block, ADC_SCAN_BLOCK_SEQUENCES);
+    }
+}
+
+/*==================================================================================================
+* STATIC FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief First SC1/R index of the scan.
+ *
+ * The eDMA source wraps over R[first..first+count-1] with its address modulo, so
+ * that window must be aligned to its own size (R[0] is at offset 0x48).
+ *
+ * @param count Number of channels (1, 2 or 4)
+ * @return uint8_t SC1/R index
+ */
+static uint8_t ADC0_Scan_FirstIndex(uint8_t count)
+{
+    uint32_t window;
+    uint32_t addr;
+
+    window = (uint32_t)count * ADC_SCAN_R_STRIDE;
+    addr   = (uint32_t)&IP_ADC0->R[0];
+
+    return (uint8_t)(((window - (addr % window)) % window) / ADC_SCAN_R_STRIDE);
+}
+
+/**
+ * @brief Configure eDMA CH0: one 16-bit result per ADC0 request, whole ping-pong
+ * buffer per major loop, interrupt at half and end.
+ *
+ * @param first First R[] index
+ * @param count Number of channels
+ */
+static void ADC0_Scan_DmaInit(uint8_t first, uint8_t count)
+{
+    uint32_t results;
+    uint16_t smod;
+
+    results = 2U * s_scanBlockLen;
+    smod    = (uint16_t)(31U - (uint32_t)__builtin_clz((uint32_t)count * ADC_SCAN_R_STRIDE));
+
+    /* eDMA and DMAMUX clocks */
+    IP_SIM->PLATCGC |= SIM_PLATCGC_CGCDMA_MASK;
+    IP_PCC->PCCn[PCC_DMAMUX_INDEX] |= PCC_PCCn_CGC_MASK;
+
+    IP_DMAMUX->CHCFG[ADC_SCAN_DMA_CH] = 0U;
+    IP_DMA->CERQ = DMA_CERQ_CERQ(ADC_SCAN_DMA_CH);
+
+    /* Source: R[first..], stepping one register and wrapping after the last channel */
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].SADDR = DMA_TCD_SADDR_SADDR((uint32_t)&IP_ADC0->R[first]);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].SOFF  = DMA_TCD_SOFF_SOFF(ADC_SCAN_R_STRIDE);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].ATTR  = DMA_TCD_ATTR_SMOD(smod) |
+                                         DMA_TCD_ATTR_SSIZE(ADC_SCAN_DMA_SIZE_16BIT) |
+                                         DMA_TCD_ATTR_DSIZE(ADC_SCAN_DMA_SIZE_16BIT);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].NBYTES.MLNO = DMA_TCD_NBYTES_MLNO_NBYTES(ADC_SCAN_RESULT_BYTES);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].SLAST = 0U;
+
+    /* Destination: ping-pong buffer, back to its start after the major loop */
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].DADDR    = DMA_TCD_DADDR_DADDR((uint32_t)&s_scanBuffer[0]);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].DOFF     = DMA_TCD_DOFF_DOFF(ADC_SCAN_RESULT_BYTES);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].DLASTSGA = DMA_TCD_DLASTSGA_DLASTSGA((uint32_t)(-(int32_t)(results * ADC_SCAN_RESULT_BYTES)));
+
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].CITER.ELINKNO = DMA_TCD_CITER_ELINKNO_CITER(results);
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].BITER.ELINKNO = DMA_TCD_BITER_ELINKNO_BITER(results);
+
+    /* DREQ = 0: the channel keeps running after each major loop */
+    IP_DMA->TCD[ADC_SCAN_DMA_CH].CSR = DMA_TCD_CSR_INTHALF_MASK | DMA_TCD_CSR_INTMAJOR_MASK;
+
+    IP_DMAMUX->CHCFG[ADC_SCAN_DMA_CH] = DMAMUX_CHCFG_SOURCE(ADC_SCAN_DMAMUX_SRC_ADC0) | DMAMUX_CHCFG_ENBL_MASK;
+    IP_DMA->SERQ = DMA_SERQ_SERQ(ADC_SCAN_DMA_CH);
+}
+
+/**
+ * @brief Enable eDMA channel 0 interrupt in NVIC with desired priority.
+ *
+ */
+static void ADC0_Scan_IrqEnable(void)
+{
+    uint32_t irqn;
+
+    irqn = (uint32_t)DMA0_IRQn;
+
+    MY_NVIC->ICPR[irqn / 32U] = (1UL << (irqn % 32U));
+    MY_NVIC->IP[irqn] = (uint8_t)((uint32_t)ADC_SCAN_IRQ_PRIORITY << (8U - NVIC_PRIO_BITS));
+    MY_NVIC->ISER[irqn / 32U] = (1UL << (irqn % 32U));
+}
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief Start the ADC0 scan (PDB0 pretriggers + eDMA ping-pong buffer).
+ *
+ * @param channels ADC0 input channels (ADCH) in conversion order
+ * @param count Number of channels: 1, 2 or 4
+ * @param callback Block complete callback
+ * @return uint8_t 1: started, 0: invalid parameter
+ */
+uint8_t ADC0_Scan_Init(const uint8_t *channels, uint8_t count, ADC0_ScanCallback_t callback)
+{
+    uint8_t  result = 0U;
+    uint8_t  first;
+    uint32_t i;
+
+    if ((channels != NULL) && ((count == 1U) || (count == 2U) || (count == 4U)))
+    {
+        first = ADC0_Scan_FirstIndex(count);
+
+        if (((uint32_t)first + count) <= PDB0_MAX_PRETRIGGERS)
+        {
+            s_scanBlockLen   = (uint32_t)ADC_SCAN_BLOCK_SEQUENCES * count;
+            s_scanCallback   = callback;
+            s_scanBlockCount = 0U;
+
+            /* Hardware trigger, DMA request on conversion complete; no COCO interrupt */
+            IP_ADC0->SC2 |= ADC_SC2_ADTRG_MASK | ADC_SC2_DMAEN_MASK;
+            for (i = 0U; i < count; i++)
+            {
+                IP_ADC0->SC1[first + i] = ADC_SC1_ADCH((uint32_t)channels[i]);
+            }
+
+            ADC0_Scan_DmaInit(first, count);
+            ADC0_Scan_IrqEnable();
+
+            result = PDB0_Init((uint8_t)PDB0_TRGMUX_SRC_LPIT0_CH0, first, count);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Number of blocks completed since ADC0_Scan_Init().
+ *
+ * @return uint32_t Block count
+ */
+uint32_t ADC0_Scan_GetBlockCount(void)
+{
+    return s_scanBlockCount;
+}
@@ -0,0 +1,377 @@
+/**
+ * @file dsp_filter.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Filters for ADC sample blocks (two channels per packed 32-bit word)
+ * @version 0.1
+ * @date 2026-03-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stddef.h>
+#include <string.h>
+#include "dsp_filter.h"
+#include "dsp_simd.h"
+#if (DSP_FILTER_BENCH == 1U)
+#include "DWT.h"
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define DSP_IIR_ONE_Q15          (32768UL)
+#define DSP_IIR_FRAC_MASK        (0x7FFFUL)
+#define DSP_IIR_ROUND_Q15        (0x4000UL)
+#define DSP_IIR_STATE_SHIFT      (3U)     /* 12-bit sample << 3 still fits a signed lane */
+
+/*==================================================================================================
+* STATIC FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint8_t  DSP_IsPowerOfTwo(uint32_t x);
+static uint32_t DSP_Bench_Start(void);
+static void     DSP_Bench_Stop(DSP_Bench_t *bench, uint32_t start, uint32_t n);
+
+/*==================================================================================================
+* STATIC FUNCTIONS
+==================================================================================================*/
+static uint8_t DSP_IsPowerOfTwo(uint32_t x)
+{
+    return ((x != 0U) && ((x & (x - 1U)) == 0U)) ? 1U : 0U;
+}
+
+/**
+ * @brief Cycle counter at the start of a Process call (enables DWT CYCCNT once)
+ *
+ * @return uint32_t CYCCNT, 0 without DSP_FILTER_BENCH
+ */
+static uint32_t DSP_Bench_Start(void)
+{
+#if (DSP_FILTER_BENCH == 1U)
+    if (0UL == (MY_DWT->CTRL & MY_DWT_CTRL_CYCCNTENA_MASK))
+    {
+        MY_DEMCR      |= MY_DEMCR_TRCENA_MASK;
+        MY_DWT->CYCCNT = 0UL;
+        MY_DWT->CTRL  |= MY_DWT_CTRL_CYCCNTENA_MASK;
+    }
+
+    return MY_DWT->CYCCNT;
+#else
+    return 0U;
+#endif
+}
+
+/**
+ * @brief Add the cycles of a Process call to the filter bench counters
+ *
+ * @param bench Bench counters
+ * @param start DSP_Bench_Start() value
+ * @param n Inputs processed
+ */
+static void DSP_Bench_Stop(DSP_Bench_t *bench, uint32_t start, uint32_t n)
+{
+#if (DSP_FILTER_BENCH == 1U)
+    bench->cycles  += MY_DWT->CYCCNT - start;
+    bench->samples += n;
+#else
+    (void)bench;
+    (void)start;
+    (void)n;
+#endif
+}
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief Initialize a moving average.
+ *
+ * @param f Filter
+ * @param len Window length, power of two (1..DSP_MAVG_MAX_LEN)
+ * @return uint8_t 1: ok, 0: invalid length
+ */
+uint8_t DSP_MovAvg_Init(DSP_MovAvg_t *f, uint32_t len)
+{
+    uint8_t result = 0U;
+
+    if ((f != NULL) && (len <= DSP_MAVG_MAX_LEN) && (DSP_IsPowerOfTwo(len) != 0U))
+    {
+        (void)memset(f, 0, sizeof(*f));
+        f->len   = len;
+        f->shift = (uint32_t)__builtin_ctz(len);
+        result   = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Filter n inputs: running sums, updated by the lane-wise (new - oldest) difference.
+ *
+ */
+void DSP_MovAvg_Process(DSP_MovAvg_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out)
+{
+    uint32_t start = DSP_Bench_Start();
+    uint32_t i;
+    uint32_t x;
+    uint32_t d;
+
+    if ((f->primed == 0U) && (n != 0U))
+    {
+        for (i = 0U; i < f->len; i++)
+        {
+            f->ring[i] = in[0];
+        }
+        f->sum0   = (int32_t)(DSP_LANE0(in[0]) << f->shift);
+        f->sum1   = (int32_t)(DSP_LANE1(in[0]) << f->shift);
+        f->primed = 1U;
+    }
+
+    for (i = 0U; i < n; i++)
+    {
+        x = in[i * stride];
+
+        /* Both lane differences in one SSUB16, they fit 16 bits (+-4095) */
+        d = DSP_SSUB16(x, f->ring[f->pos]);
+        f->ring[f->pos] = x;
+        f->pos = (f->pos + 1U) & (f->len - 1U);
+
+        f->sum0 += (int16_t)d;
+        f->sum1 += (int16_t)(d >> 16U);
+
+        out[i] = DSP_PACK((uint32_t)f->sum0 >> f->shift, (uint32_t)f->sum1 >> f->shift);
+    }
+
+    DSP_Bench_Stop(&f->bench, start, n);
+}
+
+/**
+ * @brief Initialize a single-pole IIR.
+ *
+ * @param f Filter
+ * @param alphaQ15 Smoothing factor from DSP_IIR_ALPHA_Q15(), 1..32767
+ * @return uint8_t 1: ok, 0: invalid factor
+ */
+uint8_t DSP_Iir_Init(DSP_Iir_t *f, uint16_t alphaQ15)
+{
+    uint8_t result = 0U;
+
+    if ((f != NULL) && (alphaQ15 != 0U) && (alphaQ15 < DSP_IIR_ONE_Q15))
+    {
+        (void)memset(f, 0, sizeof(*f));
+        f->coef = DSP_PACK(alphaQ15, DSP_IIR_ONE_Q15 - alphaQ15);
+        result  = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Filter n inputs: y = alpha * x + (1 - alpha) * y as one SMLAD per lane.
+ *
+ * The Q15 remainder of each update is added to the next one instead of a fixed
+ * rounding constant, so the state never stalls short of the input (without it a
+ * small alpha leaves a dead band of 0.5 / alpha state steps).
+ */
+void DSP_Iir_Process(DSP_Iir_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out)
+{
+    uint32_t start = DSP_Bench_Start();
+    uint32_t i;
+    uint32_t x;
+    uint32_t y0 = f->y0;
+    uint32_t y1 = f->y1;
+    uint32_t r0 = f->r0;
+    uint32_t r1 = f->r1;
+    uint32_t acc;
+
+    if ((f->primed == 0U) && (n != 0U))
+    {
+        y0 = DSP_LANE0(in[0]) << DSP_IIR_STATE_SHIFT;
+        y1 = DSP_LANE1(in[0]) << DSP_IIR_STATE_SHIFT;
+        r0 = DSP_IIR_ROUND_Q15;
+        r1 = DSP_IIR_ROUND_Q15;
+        f->primed = 1U;
+    }
+
+    for (i = 0U; i < n; i++)
+    {
+        x = in[i * stride];
+
+        /* All terms are non-negative: the accumulator is an unsigned Q15 value */
+        acc = (uint32_t)DSP_SMLAD(DSP_PACK(DSP_LANE0(x) << DSP_IIR_STATE_SHIFT, y0), f->coef, (int32_t)r0);
+        y0  = acc >> 15U;
+        r0  = acc & DSP_IIR_FRAC_MASK;
+        acc = (uint32_t)DSP_SMLAD(DSP_PACK(DSP_LANE1(x) << DSP_IIR_STATE_SHIFT, y1), f->coef, (int32_t)r1);
+        y1  = acc >> 15U;
+        r1  = acc & DSP_IIR_FRAC_MASK;
+
+        out[i] = DSP_PACK(DSP_USAT12((int32_t)((y0 + 4U) >> DSP_IIR_STATE_SHIFT)),
+                          DSP_USAT12((int32_t)((y1 + 4U) >> DSP_IIR_STATE_SHIFT)));
+    }
+
+    f->y0 = y0;
+    f->y1 = y1;
+    f->r0 = r0;
+    f->r1 = r1;
+
+    DSP_Bench_Stop(&f->bench, start, n);
+}
+
+/**
+ * @brief Initialize a CIC decimator.
+ *
+ * @param f Filter
+ * @param rate Decimation, power of two (2..DSP_CIC_MAX_DECIMATION)
+ * @return uint8_t 1: ok, 0: invalid rate
+ */
+uint8_t DSP_Cic_Init(DSP_Cic_t *f, uint32_t rate)
+{
+    uint8_t result = 0U;
+
+    if ((f != NULL) && (rate >= 2U) && (rate <= DSP_CIC_MAX_DECIMATION) && (DSP_IsPowerOfTwo(rate) != 0U))
+    {
+        (void)memset(f, 0, sizeof(*f));
+        f->rate  = rate;
+        f->shift = 2U * (uint32_t)__builtin_ctz(rate);
+        result   = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Filter n inputs: two integrators per input, two combs per output.
+ *
+ */
+uint32_t DSP_Cic_Process(DSP_Cic_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out)
+{
+    uint32_t start = DSP_Bench_Start();
+    uint32_t count = 0U;
+    uint32_t i;
+    uint32_t lane;
+    uint32_t x;
+    uint32_t c0;
+    uint32_t c1;
+    uint32_t res[2];
+
+    for (i = 0U; i < n; i++)
+    {
+        x = in[i * stride];
+
+        /* Integrators wrap modulo 2^32; the combs undo it exactly */
+        f->integ[0][0] += DSP_LANE0(x);
+        f->integ[0][1] += DSP_LANE1(x);
+        f->integ[1][0] += f->integ[0][0];
+        f->integ[1][1] += f->integ[0][1];
+
+        f->phase++;
+        if (f->phase == f->rate)
+        {
+            f->phase = 0U;
+
+            for (lane = 0U; lane < 2U; lane++)
+            {
+                c0 = f->integ[1][lane] - f->comb[0][lane];
+                f->comb[0][lane] = f->integ[1][lane];
+                c1 = c0 - f->comb[1][lane];
+                f->comb[1][lane] = c0;
+
+                /* Gain rate^2 removed by the shift */
+                res[lane] = DSP_USAT12((int32_t)(c1 >> f->shift));
+            }
+
+            out[count] = DSP_PACK(res[0], res[1]);
+            count++;
+        }
+    }
+
+    DSP_Bench_Stop(&f->bench, start, n);
+
+    return count;
+}
+
+/**
+ * @brief Initialize a median filter.
+ *
+ * @param f Filter
+ * @param n Window, odd (3..DSP_MEDIAN_MAX_N)
+ * @return uint8_t 1: ok, 0: invalid window
+ */
+uint8_t DSP_Median_Init(DSP_Median_t *f, uint32_t n)
+{
+    uint8_t result = 0U;
+
+    if ((f != NULL) && (n >= 3U) && (n <= DSP_MEDIAN_MAX_N) && ((n & 1U) != 0U))
+    {
+        (void)memset(f, 0, sizeof(*f));
+        f->n   = n;
+        result = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Filter n inputs: odd-even transposition sort of the window, both lanes at
+ * once with lane-wise min/max.
+ *
+ */
+void DSP_Median_Process(DSP_Median_t *f, const uint32_t *in, uint32_t stride, uint32_t n, uint32_t *out)
+{
+    uint32_t start = DSP_Bench_Start();
+    uint32_t w[DSP_MEDIAN_MAX_N];
+    uint32_t i;
+    uint32_t j;
+    uint32_t pass;
+    uint32_t lo;
+
+    if ((f->primed == 0U) && (n != 0U))
+    {
+        for (i = 0U; i < f->n; i++)
+        {
+            f->ring[i] = in[0];
+        }
+        f->primed = 1U;
+    }
+
+    for (i = 0U; i < n; i++)
+    {
+        f->ring[f->pos] = in[i * stride];
+        f->pos++;
+        if (f->pos == f->n)
+        {
+            f->pos = 0U;
+        }
+
+        (void)memcpy(w, f->ring, f->n * sizeof(w[0]));
+
+        for (pass = 0U; pass < f->n; pass++)
+        {
+            for (j = pass & 1U; (j + 1U) < f->n; j += 2U)
+            {
+                lo        = DSP_UMIN16(w[j], w[j + 1U]);
+                w[j + 1U] = DSP_UMAX16(w[j], w[j + 1U]);
+                w[j]      = lo;
+            }
+        }
+
+        out[i] = w[f->n / 2U];
+    }
+
+    DSP_Bench_Stop(&f->bench, start, n);
+}
+
+/**
+ * @brief Average cycles per input word (sample pair) of a filter.
+ *
+ * @param bench Bench counters of a filter
+ * @return uint32_t Cycles per input, 0 before the first Process call or without DSP_FILTER_BENCH
+ */
+uint32_t DSP_Bench_CyclesPerSample(const DSP_Bench_t *bench)
+{
+    return (bench->samples != 0U) ? (bench->cycles / bench->samples) : 0U;
+}
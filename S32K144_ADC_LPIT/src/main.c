@@ -16,6 +16,11 @@
 #include "clocks_and_modes.h"
 #include "adc.h"
 #include "Timer_LPIT.h"
+#include "pdb.h"
+#include "adc_scan.h"
+#include "adc_conv.h"
+#include "dsp_filter.h"
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
@@ -29,15 +34,40 @@
 #define LED_GREEN_MASK              (1UL << LED_GREEN_PIN)
 #define LED_ALL_MASK                (LED_RED_MASK | LED_BLUE_MASK | LED_GREEN_MASK)
 
-/* ADC conversion scaling (adjust ADC_REF_MV_F to your board VDDA/VREF)
- * ADC 12-bit => code range 0..4095 (2^12 - 1). Used to scale ADC counts to voltage. */
-#define ADC_MAX_COUNT_F             (4095.0f)
-#define ADC_REF_MV_F                (5000.0f)
+/* Sampling modes */
+#define ADC_MODE_SW_TRIGGER         (0U)  /* LPIT0 CH0 interrupt starts each conversion (1 kHz) */
+#define ADC_MODE_HW_TRIGGER         (1U)  /* LPIT0 CH0 -> TRGMUX -> PDB0 -> ADC0, COCO interrupt */
+#define ADC_MODE_DMA_SCAN           (2U)  /* Same trigger, channel scan moved by eDMA in blocks */
+#define ADC_MODE_HW_COMPARE         (3U)  /* HW trigger, ADC compare: interrupt on band crossings only */
+/* Build option (-DADC_MODE=n); the filtered eDMA scan is the default */
+#ifndef ADC_MODE
+#define ADC_MODE                    (ADC_MODE_DMA_SCAN)
+#endif
+
+/* Hardware trigger sample rate, up to LPIT0_TRIGGER_MAX_HZ */
+#define ADC_SAMPLE_RATE_HZ          (1000U)
+
+/* Scan channels: PTA6 (ADC0_SE2) and the VREFSH reference */
+#define ADC_SCAN_CH_PTA6            (2U)
+#define ADC_SCAN_CH_VREFSH          (29U)
+#define ADC_SCAN_CHANNELS           (2U)
+
+/* Scan block smoothing: median removes spikes, IIR the remaining noise */
+#define ADC_FILTER_MEDIAN_N         (3U)
+#define ADC_FILTER_IIR_ALPHA        (0.125F)
+
+/* ADC reference (adjust ADC_REF_MV to your board VDDA/VREF), 12-bit code range 0..4095 */
+#define ADC_REF_MV                  (5000U)
 
 /* Voltage thresholds in mV */
-#define THRESH_RED_MV_F             (3750.0f)
-#define THRESH_GREEN_MV_F           (2500.0f)
-#define THRESH_BLUE_MV_F            (1250.0f)
+#define THRESH_RED_MV               (3750U)
+#define THRESH_GREEN_MV             (2500U)
+#define THRESH_BLUE_MV              (1250U)
+
+#define LED_BANDS                   (4U)
+
+/* Compare range is the band widened by this many codes: noise at a threshold does not wake */
+#define ADC_COMPARE_HYST_CODES      (8U)
 
 /*==================================================================================================
 * PROTOTYPES
@@ -46,10 +76,36 @@ static void WDOG_Disable(void);
 static void App_InitSystemClock(void);
 static void App_InitLeds(void);
 static void App_AllLedsOff(void);
-static void App_SetLedRedOnly(void);
-static void App_SetLedGreenOnly(void);
-static void App_SetLedBlueOnly(void);
-static void App_UpdateLeds(float vol_mv);
+static uint32_t App_UpdateLeds(uint16_t code);
+#if (ADC_MODE == ADC_MODE_HW_COMPARE)
+static void App_ArmCompare(uint32_t band);
+#endif
+#if (ADC_MODE == ADC_MODE_DMA_SCAN)
+static void App_ScanBlock(const uint16_t *block, uint32_t sequences);
+#endif
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+/* Thresholds as ADC codes, computed at compile time: samples are never converted to mV */
+static const uint16_t s_levelCodes[LED_BANDS - 1U] =
+{
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_BLUE_MV, ADC_REF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_GREEN_MV, ADC_REF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(THRESH_RED_MV, ADC_REF_MV)
+};
+
+/* LED that is ON in each band (all OFF at or below THRESH_BLUE_MV) */
+static const uint32_t s_bandLedMask[LED_BANDS] = { 0U, LED_BLUE_MASK, LED_GREEN_MASK, LED_RED_MASK };
+
+#if (ADC_MODE == ADC_MODE_DMA_SCAN)
+static const uint8_t s_scanChannels[ADC_SCAN_CHANNELS] = { ADC_SCAN_CH_PTA6, ADC_SCAN_CH_VREFSH };
+
+/* Filter state; each bench field holds the cycles per sample pair (debugger view) */
+static DSP_Median_t s_median;
+static DSP_Iir_t    s_iir;
+static uint32_t     s_filtered[ADC_SCAN_BLOCK_SEQUENCES];
+#endif
 
 /*==================================================================================================
 * FUNCTIONS
@@ -76,9 +132,14 @@ void WDOG_Disable(void)
  */
 void App_InitSystemClock(void)
 {
-    SOSC_init_8MHz();
-    SPLL_init_160MHz();
-    NormalRUNmode_80MHz();
+    /* SysTick time base first: it bounds the clock waits */
+    Time_Init();
+
+    /* A step that times out leaves the core on the 48 MHz FIRC */
+    if ((0U != SOSC_init_8MHz()) && (0U != SPLL_init_160MHz()))
+    {
+        (void)NormalRUNmode_80MHz();
+    }
 }
 
 /**
@@ -113,92 +174,119 @@ void App_AllLedsOff(void)
 }
 
 /**
- * @brief Turn ON only the RED LED.
+ * @brief Update LEDs based on the raw ADC code.
  *
  */
-void App_SetLedRedOnly(void)
+uint32_t App_UpdateLeds(uint16_t code)
 {
-	/* Active-low: clear output => LED ON. */
-    App_AllLedsOff();
-    IP_PTD->PCOR = LED_RED_MASK;
-}
+    uint32_t band;
+    uint32_t ledOn;
 
-/**
- * @brief Turn ON only the GREEN LED.
- *
- */
-void App_SetLedGreenOnly(void)
-{
-    App_AllLedsOff();
-    IP_PTD->PCOR = LED_GREEN_MASK;
+    band  = ADC_Conv_Band(code, s_levelCodes, LED_BANDS - 1U);
+    ledOn = s_bandLedMask[band];
+
+    /* Active-low: set output high => LED OFF, clear => LED ON. */
+    IP_PTD->PSOR = LED_ALL_MASK & ~ledOn;
+    IP_PTD->PCOR = ledOn;
+
+    return band;
 }
 
+#if (ADC_MODE == ADC_MODE_HW_COMPARE)
 /**
- * @brief Turn ON only the BLUE LED.
+ * @brief Re-arm the ADC compare around the current band (plus hysteresis).
  *
  */
-void App_SetLedBlueOnly(void)
+void App_ArmCompare(uint32_t band)
 {
-    App_AllLedsOff();
-    IP_PTD->PCOR = LED_BLUE_MASK;
+    uint16_t low;
+    uint16_t high;
+
+    ADC_Conv_BandRange(band, s_levelCodes, LED_BANDS - 1U, &low, &high);
+
+    low  = (low > ADC_COMPARE_HYST_CODES) ? (uint16_t)(low - ADC_COMPARE_HYST_CODES) : 0U;
+    high = ((high + ADC_COMPARE_HYST_CODES) < ADC_CONV_MAX_CODE) ?
+           (uint16_t)(high + ADC_COMPARE_HYST_CODES) : (uint16_t)ADC_CONV_MAX_CODE;
+
+    ADC0_SetCompareRange(low, high);
 }
+#endif
 
+#if (ADC_MODE == ADC_MODE_DMA_SCAN)
 /**
- * @brief Update LEDs based on measured voltage.
+ * @brief ADC scan block callback (DMA0 interrupt): filter both channels of the block
+ * (one packed word per sequence) and publish the last PTA6 output.
  *
  */
-void App_UpdateLeds(float vol_mv)
+void App_ScanBlock(const uint16_t *block, uint32_t sequences)
 {
-    /* Update LED state based on measured voltage thresholds. */
-    if ((vol_mv > THRESH_RED_MV_F) && (vol_mv <= ADC_REF_MV_F))
-    {
-        App_SetLedRedOnly();
-    }
-    else if ((vol_mv > THRESH_GREEN_MV_F) && (vol_mv <= THRESH_RED_MV_F))
-    {
-        App_SetLedGreenOnly();
-    }
-    else if ((vol_mv > THRESH_BLUE_MV_F) && (vol_mv <= THRESH_GREEN_MV_F))
-    {
-        App_SetLedBlueOnly();
-    }
-    else
-    {
-        /* vol_mv <= THRESH_BLUE_MV_F (or out of expected range): all LEDs OFF. */
-        App_AllLedsOff();
-    }
+    const uint32_t *pairs = (const uint32_t *)(const void *)block;
+
+    DSP_Median_Process(&s_median, pairs, 1U, sequences, s_filtered);
+    DSP_Iir_Process(&s_iir, s_filtered, 1U, sequences, s_filtered);
+
+    g_adcResult = (uint16_t)(s_filtered[sequences - 1U] & 0xFFFFU);
+    g_adcNew    = 1U;
 }
+#endif
 
 /*==================================================================================================
 * MAIN FUNCTION
 ==================================================================================================*/
 int main(void)
 {
-    float vol_mv = 0.0f;
+    uint32_t band;
 
     WDOG_Disable();
     App_InitSystemClock();
     App_InitLeds();
 
-    /* ADC0 is configured for software trigger. Result/flag are updated in ADC0_IRQHandler().
+    /* Result/flag are updated in ADC0_IRQHandler().
      * Note: g_adcResult and g_adcNew are global (extern) to share data between ISR and main loop.
      */
-    ADC0_Init();
+    (void)ADC0_Init();
 
+#if (ADC_MODE == ADC_MODE_DMA_SCAN)
+    /* Each trigger converts all scan channels; one DMA interrupt per ADC_SCAN_BLOCK_SEQUENCES */
+    (void)DSP_Median_Init(&s_median, ADC_FILTER_MEDIAN_N);
+    (void)DSP_Iir_Init(&s_iir, DSP_IIR_ALPHA_Q15(ADC_FILTER_IIR_ALPHA));
+    (void)ADC0_Scan_Init(s_scanChannels, (uint8_t)ADC_SCAN_CHANNELS, App_ScanBlock);
+    (void)LPIT0_InitTrigger(ADC_SAMPLE_RATE_HZ);
+#elif ((ADC_MODE == ADC_MODE_HW_TRIGGER) || (ADC_MODE == ADC_MODE_HW_COMPARE))
+    /* Compare mode starts without compare: the first sample sets the band and arms it.
+     * PDB0 waits for the LPIT0 CH0 trigger, then starts SC1[0]: one ADC interrupt per sample */
+    (void)PDB0_Init((uint8_t)PDB0_TRGMUX_SRC_LPIT0_CH0, 0U, 1U);
+    ADC0_EnableHwTrigger();
+    (void)LPIT0_InitTrigger(ADC_SAMPLE_RATE_HZ);
+#else
     /* LPIT0 must be configured to generate periodic IRQ (CH0) for sampling. */
     LPIT0_Init();
+#endif
 
     while (1)
     {
+        /* Sleep until an interrupt publishes a result. WFI also wakes on an interrupt
+         * that became pending while masked, so a flag set after the check is not missed. */
+        DISABLE_INTERRUPTS();
+        if (g_adcNew == 0U)
+        {
+            STANDBY();
+        }
+        ENABLE_INTERRUPTS();
+
         if (g_adcNew != 0U)
         {
             g_adcNew = 0U;
 
-            /* Convert ADC counts to millivolts. */
-            vol_mv = ((float)g_adcResult / ADC_MAX_COUNT_F) * ADC_REF_MV_F;
+            /* Update LEDs based on the voltage band of the raw code. */
+            band = App_UpdateLeds(g_adcResult);
 
-            /* Update LEDs based on voltage. */
-            App_UpdateLeds(vol_mv);
+#if (ADC_MODE == ADC_MODE_HW_COMPARE)
+            /* Next interrupt only when the input leaves this band */
+            App_ArmCompare(band);
+#else
+            (void)band;
+#endif
         }
     }
 
@@ -0,0 +1,92 @@
+/**
+ * @file pdb.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief PDB0 hardware trigger driver for ADC0 on S32K144
+ * @version 0.1
+ * @date 2026-03-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include "pdb.h"
+#include "device_registers.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define PDB0_TRGSEL_TRGMUX       (0U)       /* SC[TRGSEL]: trigger input 0 = TRGMUX output */
+#define PDB0_MOD_VALUE           (0xFFFFU)  /* One-shot counter; a new trigger restarts it */
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief Route a TRGMUX source to PDB0 and enable ADC0 pretriggers.
+ *
+ * @param trgmuxSource TRGMUX source of the trigger (PDB0_TRGMUX_SRC_*)
+ * @param first First ADC0 pretrigger / SC1 index
+ * @param count Number of pretriggers (first + count <= PDB0_MAX_PRETRIGGERS)
+ * @return uint8_t 1: configured, 0: invalid pretrigger range
+ */
+uint8_t PDB0_Init(uint8_t trgmuxSource, uint8_t first, uint8_t count)
+{
+    uint32_t enable;
+    uint8_t  result = 0U;
+
+    if ((count != 0U) && (((uint32_t)first + count) <= PDB0_MAX_PRETRIGGERS))
+    {
+        enable = ((1UL << count) - 1U) << first;
+
+        IP_PCC->PCCn[PCC_PDB0_INDEX] |= PCC_PCCn_CGC_MASK;
+
+        /* TRGMUX output of PDB0 follows the selected source (SEL0 = PDB0 trigger in) */
+        IP_TRGMUX->TRGMUXn[TRGMUX_PDB0_INDEX] =
+            (IP_TRGMUX->TRGMUXn[TRGMUX_PDB0_INDEX] & ~TRGMUX_TRGMUXn_SEL0_MASK) |
+            TRGMUX_TRGMUXn_SEL0((uint32_t)trgmuxSource);
+
+        /* ADC0 trigger and pretriggers come from PDB0 (reset default, set explicitly) */
+        IP_SIM->ADCOPT &= ~(SIM_ADCOPT_ADC0TRGSEL_MASK | SIM_ADCOPT_ADC0PRETRGSEL_MASK);
+
+        /* One-shot, bus clock without prescaler, hardware trigger from TRGMUX */
+        IP_PDB0->SC = PDB_SC_PDBEN_MASK | PDB_SC_TRGSEL(PDB0_TRGSEL_TRGMUX);
+        IP_PDB0->MOD = PDB_MOD_MOD(PDB0_MOD_VALUE);
+
+        /* First pretrigger right after the trigger (TOS = 0), the others back-to-back */
+        IP_PDB0->CH[0].C1 = PDB_C1_EN(enable) | PDB_C1_BB(enable & ~(1UL << first));
+        IP_PDB0->CH[1].C1 = 0U;
+
+        IP_PDB0->CH[0].S = 0U;
+
+        /* Load MOD/C1 buffers */
+        IP_PDB0->SC |= PDB_SC_LDOK_MASK;
+
+        result = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read and clear the ADC0 pretrigger sequence errors.
+ *
+ * @return uint8_t Error flag of each pretrigger, 0: no sample lost
+ */
+uint8_t PDB0_GetSequenceErrors(void)
+{
+    uint32_t err;
+
+    err = IP_PDB0->CH[0].S & PDB_S_ERR_MASK;
+
+    if (err != 0U)
+    {
+        /* ERR flags clear on writing 0, writing 1 has no effect */
+        IP_PDB0->CH[0].S = ~err & PDB_S_ERR_MASK;
+    }
+
+    return (uint8_t)err;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file adc_conv_check.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Host check of the fixed-point ADC conversion against the float path
+ * @version 0.1
+ * @date 2026-03-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build (host, not part of the S32DS project):
+ *   gcc -O2 -Wall -I../include -o adc_conv_check adc_conv_check.c ../src/adc_conv.c -lm
+ *   ./adc_conv_check
+ *
+ * Checks, for all 4096 codes:
+ *   - ADC_Conv_Band() against the float compare chain the demos used
+ *     ((code / 4095.0f) * ref > threshold) for the demo thresholds;
+ *   - ADC_CONV_CODE_ABOVE() for every whole-mV threshold 0..ref at 3300 and
+ *     5000 mV: a difference is allowed only where the voltage equals the
+ *     threshold exactly and the float result rounds above it;
+ *   - ADC_Conv_ToMv() against the rounded float voltage (at most 1 mV apart);
+ *   - ADC_Conv_BandRange() against ADC_Conv_Band().
+ * Exit code 0 when every check passes.
+ *
+ * The timing printed at the end is host time per sample. It does not carry
+ * over to the M4 (a host FPU pipelines the divide, VDIV.F32 takes 14 cycles
+ * and an interrupt using the FPU adds lazy stacking). Cycles on the M4 come
+ * from the DWT cycle counter (DWT.h): set MY_DEMCR_TRCENA_MASK and
+ * MY_DWT_CTRL_CYCCNTENA_MASK, read MY_DWT->CYCCNT before and after a loop
+ * of App_UpdateLeds() over a block of codes and divide by the block length.
+ */
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "adc_conv.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define CHECK_CODES             (ADC_CONV_MAX_CODE + 1U)
+#define CHECK_LEVELS            (3U)
+#define CHECK_TIMING_ROUNDS     (20000U)
+
+/* Demo configuration (main.c) */
+#define CHECK_REF_MV            (5000U)
+#define CHECK_THRESH_BLUE_MV    (1250U)
+#define CHECK_THRESH_GREEN_MV   (2500U)
+#define CHECK_THRESH_RED_MV     (3750U)
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+static const uint16_t s_levelCodes[CHECK_LEVELS] =
+{
+    (uint16_t)ADC_CONV_CODE_ABOVE(CHECK_THRESH_BLUE_MV, CHECK_REF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(CHECK_THRESH_GREEN_MV, CHECK_REF_MV),
+    (uint16_t)ADC_CONV_CODE_ABOVE(CHECK_THRESH_RED_MV, CHECK_REF_MV)
+};
+
+static uint16_t          s_codes[CHECK_CODES];
+static volatile uint32_t s_sink;
+
+/*==================================================================================================
+* LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Voltage of a code as the demos computed it.
+ *
+ */
+static float Check_FloatMv(uint16_t code, uint32_t refMv)
+{
+    return ((float)code / 4095.0f) * (float)refMv;
+}
+
+/**
+ * @brief Band of the float compare chain (App_UpdateLeds before the fixed-point change).
+ *
+ */
+static uint32_t Check_FloatBand(uint16_t code)
+{
+    float    volMv = Check_FloatMv(code, CHECK_REF_MV);
+    uint32_t band;
+
+    if (volMv > (float)CHECK_THRESH_RED_MV)
+    {
+        band = 3U;
+    }
+    else if (volMv > (float)CHECK_THRESH_GREEN_MV)
+    {
+        band = 2U;
+    }
+    else if (volMv > (float)CHECK_THRESH_BLUE_MV)
+    {
+        band = 1U;
+    }
+    else
+    {
+        band = 0U;
+    }
+
+    return band;
+}
+
+/**
+ * @brief Demo thresholds: fixed band equals float band for every code.
+ *
+ */
+static uint32_t Check_DemoBands(void)
+{
+    uint32_t errors = 0U;
+    uint32_t code;
+
+    for (code = 0U; code < CHECK_CODES; code++)
+    {
+        if (ADC_Conv_Band((uint16_t)code, s_levelCodes, CHECK_LEVELS) != Check_FloatBand((uint16_t)code))
+        {
+            printf("band mismatch at code %u\n", (unsigned)code);
+            errors++;
+        }
+    }
+
+    printf("demo bands      : %u codes, %u mismatches (levels %u %u %u)\n",
+           (unsigned)CHECK_CODES, (unsigned)errors,
+           (unsigned)s_levelCodes[0], (unsigned)s_levelCodes[1], (unsigned)s_levelCodes[2]);
+
+    return errors;
+}
+
+/**
+ * @brief ADC_CONV_CODE_ABOVE() for every whole-mV threshold of a reference.
+ *
+ */
+static uint32_t Check_AllThresholds(uint32_t refMv)
+{
+    uint32_t errors = 0U;
+    uint32_t edges  = 0U;
+    uint32_t mv;
+    uint32_t code;
+    uint32_t above;
+
+    for (mv = 0U; mv <= refMv; mv++)
+    {
+        above = ADC_CONV_CODE_ABOVE(mv, refMv);
+
+        for (code = 0U; code < CHECK_CODES; code++)
+        {
+            if ((code >= above) == (Check_FloatMv((uint16_t)code, refMv) > (float)mv))
+            {
+                /* Same decision */
+            }
+            else if ((code * refMv) == (mv * ADC_CONV_MAX_CODE))
+            {
+                /* Exactly at the threshold: not above it, the float path rounded */
+                edges++;
+            }
+            else
+            {
+                if (errors < 5U)
+                {
+                    printf("threshold %u mV @ %u mV: code %u differs\n",
+                           (unsigned)mv, (unsigned)refMv, (unsigned)code);
+                }
+                errors++;
+            }
+        }
+    }
+
+    printf("thresholds %4u : %u thresholds x %u codes, %u mismatches, %u float rounding at an exact edge\n",
+           (unsigned)refMv, (unsigned)(refMv + 1U), (unsigned)CHECK_CODES, (unsigned)errors, (unsigned)edges);
+
+    return errors;
+}
+
+/**
+ * @brief ADC_Conv_ToMv() within 1 mV of the rounded float voltage.
+ *
+ */
+static uint32_t Check_ToMv(uint32_t refMv)
+{
+    uint32_t errors = 0U;
+    uint32_t exact  = 0U;
+    uint32_t scale  = ADC_CONV_MV_PER_CODE_Q16(refMv);
+    uint32_t code;
+    long     diff;
+
+    for (code = 0U; code < CHECK_CODES; code++)
+    {
+        diff = (long)ADC_Conv_ToMv((uint16_t)code, scale) - lroundf(Check_FloatMv((uint16_t)code, refMv));
+
+        exact += (0L == diff) ? 1U : 0U;
+        if (labs(diff) > 1L)
+        {
+            printf("ToMv @ %u mV: code %u off by %ld mV\n", (unsigned)refMv, (unsigned)code, diff);
+            errors++;
+        }
+    }
+
+    printf("to mV      %4u : %u of %u codes exact, %u off by more than 1 mV\n",
+           (unsigned)refMv, (unsigned)exact, (unsigned)CHECK_CODES, (unsigned)errors);
+
+    return errors;
+}
+
+/**
+ * @brief ADC_Conv_BandRange() covers exactly the codes of its band.
+ *
+ */
+static uint32_t Check_BandRange(void)
+{
+    uint32_t errors = 0U;
+    uint32_t code;
+    uint32_t band;
+    uint16_t low;
+    uint16_t high;
+
+    for (code = 0U; code < CHECK_CODES; code++)
+    {
+        band = ADC_Conv_Band((uint16_t)code, s_levelCodes, CHECK_LEVELS);
+        ADC_Conv_BandRange(band, s_levelCodes, CHECK_LEVELS, &low, &high);
+
+        if ((code < low) || (code > high))
+        {
+            printf("band range: code %u outside [%u, %u] of band %u\n",
+                   (unsigned)code, (unsigned)low, (unsigned)high, (unsigned)band);
+            errors++;
+        }
+    }
+
+    printf("band ranges     : %u mismatches\n", (unsigned)errors);
+
+    return errors;
+}
+
+/**
+ * @brief Monotonic time in ns.
+ *
+ */
+static double Check_NowNs(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return ((double)t.tv_sec * 1e9) + (double)t.tv_nsec;
+}
+
+/**
+ * @brief Host time per sample of both paths over shuffled codes.
+ *
+ */
+static void Check_Timing(void)
+{
+    uint32_t round;
+    uint32_t i;
+    uint32_t j;
+    uint16_t tmp;
+    uint32_t acc = 0U;
+    double   t0;
+    double   tFloat;
+    double   tFixed;
+
+    for (i = 0U; i < CHECK_CODES; i++)
+    {
+        s_codes[i] = (uint16_t)i;
+    }
+    srand(1U);
+    for (i = CHECK_CODES - 1U; i > 0U; i--)
+    {
+        /* Shuffled: the band branches of the float chain are not predictable */
+        j          = (uint32_t)rand() % (i + 1U);
+        tmp        = s_codes[i];
+        s_codes[i] = s_codes[j];
+        s_codes[j] = tmp;
+    }
+
+    t0 = Check_NowNs();
+    for (round = 0U; round < CHECK_TIMING_ROUNDS; round++)
+    {
+        for (i = 0U; i < CHECK_CODES; i++)
+        {
+            acc += Check_FloatBand(s_codes[i]);
+        }
+        s_sink = acc;
+    }
+    tFloat = (Check_NowNs() - t0) / ((double)CHECK_TIMING_ROUNDS * CHECK_CODES);
+
+    t0 = Check_NowNs();
+    for (round = 0U; round < CHECK_TIMING_ROUNDS; round++)
+    {
+        for (i = 0U; i < CHECK_CODES; i++)
+        {
+            acc += ADC_Conv_Band(s_codes[i], s_levelCodes, CHECK_LEVELS);
+        }
+        s_sink = acc;
+    }
+    tFixed = (Check_NowNs() - t0) / ((double)CHECK_TIMING_ROUNDS * CHECK_CODES);
+
+    printf("host time/sample: float %.2f ns, fixed %.2f ns\n", tFloat, tFixed);
+}
+
+/*==================================================================================================
+* MAIN FUNCTION
+==================================================================================================*/
+int main(void)
+{
+    uint32_t errors = 0U;
+
+    errors += Check_DemoBands();
+    errors += Check_AllThresholds(3300U);
+    errors += Check_AllThresholds(CHECK_REF_MV);
+    errors += Check_ToMv(3300U);
+    errors += Check_ToMv(CHECK_REF_MV);
+    errors += Check_BandRange();
+
+    Check_Timing();
+
+    printf("%s\n", (0U == errors) ? "PASS" : "FAIL");
+
+    return (0U == errors) ? 0 : 1;
+}
@@ -0,0 +1,390 @@
+/**
+ * @file dsp_filter_check.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Host check of the packed filters against scalar reference implementations
+ * @version 0.1
+ * @date 2026-03-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build (host, not part of the S32DS project; uses the portable C path of dsp_simd.h):
+ *   gcc -O2 -Wall -I../include -o dsp_filter_check dsp_filter_check.c ../src/dsp_filter.c -lm
+ *   ./dsp_filter_check
+ *
+ * Each filter runs on streams of 12-bit sample pairs (random, full-scale
+ * steps, constant), fed in random block sizes with stride 1 and 2 so the
+ * state carried between Process calls is covered. Every output is compared
+ * with a plain per-lane implementation of the same definition:
+ *   - moving average: mean (rounded down) of the last len inputs, the
+ *     window filled with the first input;
+ *   - IIR: y = alpha * x + (1 - alpha) * y in 64-bit integers with the same
+ *     state scaling and carried Q15 remainder (exact), and in double (at
+ *     most 1 code apart, for alpha down to 1 / 32768);
+ *   - CIC: direct convolution with the triangular impulse response of two
+ *     cascaded length-rate box filters, zero initial state, every rate-th
+ *     output, divided by rate^2;
+ *   - median: middle of the sorted last n inputs, the window filled with
+ *     the first input.
+ * Exit code 0 when every output matches.
+ */
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dsp_filter.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define CHECK_LEN               (4096U)     /* Sample pairs per stream */
+#define CHECK_STREAMS           (3U)
+#define CHECK_MAX_BLOCK         (40U)
+#define CHECK_MAX_STRIDE        (2U)
+#define CHECK_MAX_CODE          (4095U)
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+static uint16_t s_lane[2][CHECK_LEN];                        /* Input per lane */
+static uint32_t s_in[CHECK_LEN * CHECK_MAX_STRIDE];          /* Packed, strided */
+static uint32_t s_out[CHECK_LEN + 1U];
+static uint16_t s_ref[2][CHECK_LEN];
+static uint32_t s_errors;
+
+/*==================================================================================================
+* LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Fill both lanes with test stream k and pack them with the given stride.
+ *
+ */
+static void Check_MakeStream(uint32_t k, uint32_t stride)
+{
+    uint32_t i;
+    uint32_t lane;
+
+    for (i = 0U; i < CHECK_LEN; i++)
+    {
+        for (lane = 0U; lane < 2U; lane++)
+        {
+            if (k == 0U)
+            {
+                s_lane[lane][i] = (uint16_t)((uint32_t)rand() % (CHECK_MAX_CODE + 1U));
+            }
+            else if (k == 1U)
+            {
+                /* Full-scale steps, the lanes out of phase */
+                s_lane[lane][i] = ((((i / 37U) + lane) & 1U) != 0U) ? (uint16_t)CHECK_MAX_CODE : 0U;
+            }
+            else
+            {
+                s_lane[lane][i] = (lane == 0U) ? (uint16_t)CHECK_MAX_CODE : 1234U;
+            }
+        }
+    }
+
+    /* The word between two pairs (stride 2) is another channel: must be ignored */
+    for (i = 0U; i < (CHECK_LEN * stride); i++)
+    {
+        s_in[i] = 0xDEADBEEFUL;
+    }
+    for (i = 0U; i < CHECK_LEN; i++)
+    {
+        s_in[i * stride] = (uint32_t)s_lane[0][i] | ((uint32_t)s_lane[1][i] << 16U);
+    }
+}
+
+/**
+ * @brief Random block size for the next Process call.
+ *
+ */
+static uint32_t Check_Block(uint32_t left)
+{
+    uint32_t n = ((uint32_t)rand() % CHECK_MAX_BLOCK) + 1U;
+
+    return (n < left) ? n : left;
+}
+
+/**
+ * @brief Compare count outputs with the reference lanes.
+ *
+ */
+static void Check_Compare(const char *name, uint32_t count)
+{
+    uint32_t i;
+    uint32_t lane;
+    uint32_t got;
+    uint32_t errors = 0U;
+
+    for (i = 0U; i < count; i++)
+    {
+        for (lane = 0U; lane < 2U; lane++)
+        {
+            got = (lane == 0U) ? (s_out[i] & 0xFFFFUL) : (s_out[i] >> 16U);
+            if (got != s_ref[lane][i])
+            {
+                if (errors < 5U)
+                {
+                    printf("%s: output %u lane %u is %u, reference %u\n",
+                           name, (unsigned)i, (unsigned)lane, (unsigned)got, (unsigned)s_ref[lane][i]);
+                }
+                errors++;
+            }
+        }
+    }
+
+    s_errors += errors;
+    if (errors != 0U)
+    {
+        printf("%s: %u mismatches\n", name, (unsigned)errors);
+    }
+}
+
+/**
+ * @brief Moving average against the mean of the last len inputs.
+ *
+ */
+static void Check_MovAvg(uint32_t len, uint32_t stride)
+{
+    DSP_MovAvg_t f;
+    uint32_t     done;
+    uint32_t     n;
+    uint32_t     i;
+    uint32_t     j;
+    uint32_t     lane;
+    uint32_t     sum;
+
+    (void)DSP_MovAvg_Init(&f, len);
+    for (done = 0U; done < CHECK_LEN; done += n)
+    {
+        n = Check_Block(CHECK_LEN - done);
+        DSP_MovAvg_Process(&f, &s_in[done * stride], stride, n, &s_out[done]);
+    }
+
+    for (lane = 0U; lane < 2U; lane++)
+    {
+        for (i = 0U; i < CHECK_LEN; i++)
+        {
+            sum = 0U;
+            for (j = 0U; j < len; j++)
+            {
+                sum += (i >= j) ? s_lane[lane][i - j] : s_lane[lane][0];
+            }
+            s_ref[lane][i] = (uint16_t)(sum / len);
+        }
+    }
+
+    Check_Compare("movavg", CHECK_LEN);
+}
+
+/**
+ * @brief IIR against the integer recurrence (exact) and the real one (1 code).
+ *
+ */
+static void Check_Iir(uint16_t alphaQ15, uint32_t stride)
+{
+    DSP_Iir_t f;
+    uint32_t  done;
+    uint32_t  n;
+    uint32_t  i;
+    uint32_t  lane;
+    int64_t   y;
+    int64_t   acc;
+    int64_t   r;
+    double    yr;
+    double    a = (double)alphaQ15 / 32768.0;
+    double    dev;
+    double    maxDev = 0.0;
+    int32_t   o;
+
+    (void)DSP_Iir_Init(&f, alphaQ15);
+    for (done = 0U; done < CHECK_LEN; done += n)
+    {
+        n = Check_Block(CHECK_LEN - done);
+        DSP_Iir_Process(&f, &s_in[done * stride], stride, n, &s_out[done]);
+    }
+
+    for (lane = 0U; lane < 2U; lane++)
+    {
+        /* State is the sample times 8, primed with the first input */
+        y  = (int64_t)s_lane[lane][0] * 8;
+        r  = 0x4000;
+        yr = (double)s_lane[lane][0];
+
+        for (i = 0U; i < CHECK_LEN; i++)
+        {
+            acc = ((int64_t)alphaQ15 * ((int64_t)s_lane[lane][i] * 8)) +
+                  ((int64_t)(32768 - alphaQ15) * y) + r;
+            y   = acc >> 15;
+            r   = acc & 0x7FFF;
+            yr = (a * (double)s_lane[lane][i]) + ((1.0 - a) * yr);
+
+            o = (int32_t)((y + 4) >> 3);
+            o = (o < 0) ? 0 : ((o > (int32_t)CHECK_MAX_CODE) ? (int32_t)CHECK_MAX_CODE : o);
+            s_ref[lane][i] = (uint16_t)o;
+
+            dev = fabs((double)o - yr);
+            maxDev = (dev > maxDev) ? dev : maxDev;
+        }
+    }
+
+    Check_Compare("iir", CHECK_LEN);
+
+    if (maxDev > 1.0)
+    {
+        printf("iir: alpha %u: %.3f codes from the real recurrence\n", (unsigned)alphaQ15, maxDev);
+        s_errors++;
+    }
+}
+
+/**
+ * @brief CIC against direct convolution with the triangular impulse response.
+ *
+ */
+static void Check_Cic(uint32_t rate, uint32_t stride)
+{
+    DSP_Cic_t f;
+    uint32_t  done;
+    uint32_t  n;
+    uint32_t  count = 0U;
+    uint32_t  k;
+    uint32_t  j;
+    uint32_t  lane;
+    uint32_t  m;
+    uint64_t  acc;
+    uint64_t  h;
+
+    (void)DSP_Cic_Init(&f, rate);
+    for (done = 0U; done < CHECK_LEN; done += n)
+    {
+        n = Check_Block(CHECK_LEN - done);
+        count += DSP_Cic_Process(&f, &s_in[done * stride], stride, n, &s_out[count]);
+    }
+
+    if (count != (CHECK_LEN / rate))
+    {
+        printf("cic: %u outputs, expected %u\n", (unsigned)count, (unsigned)(CHECK_LEN / rate));
+        s_errors++;
+    }
+
+    for (lane = 0U; lane < 2U; lane++)
+    {
+        for (k = 0U; k < (CHECK_LEN / rate); k++)
+        {
+            /* Output k is produced by input m = (k + 1) * rate - 1 */
+            m   = ((k + 1U) * rate) - 1U;
+            acc = 0U;
+
+            for (j = 0U; (j < ((2U * rate) - 1U)) && (j <= m); j++)
+            {
+                h    = (j < rate) ? (j + 1U) : ((2U * rate) - 1U - j);
+                acc += h * s_lane[lane][m - j];
+            }
+
+            acc /= (uint64_t)rate * rate;
+            s_ref[lane][k] = (uint16_t)((acc > CHECK_MAX_CODE) ? CHECK_MAX_CODE : acc);
+        }
+    }
+
+    Check_Compare("cic", CHECK_LEN / rate);
+}
+
+/**
+ * @brief qsort comparator.
+ *
+ */
+static int Check_CmpU16(const void *a, const void *b)
+{
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+/**
+ * @brief Median against sorting the last n inputs.
+ *
+ */
+static void Check_Median(uint32_t win, uint32_t stride)
+{
+    DSP_Median_t f;
+    uint32_t     done;
+    uint32_t     n;
+    uint32_t     i;
+    uint32_t     j;
+    uint32_t     lane;
+    uint16_t     w[DSP_MEDIAN_MAX_N];
+
+    (void)DSP_Median_Init(&f, win);
+    for (done = 0U; done < CHECK_LEN; done += n)
+    {
+        n = Check_Block(CHECK_LEN - done);
+        DSP_Median_Process(&f, &s_in[done * stride], stride, n, &s_out[done]);
+    }
+
+    for (lane = 0U; lane < 2U; lane++)
+    {
+        for (i = 0U; i < CHECK_LEN; i++)
+        {
+            for (j = 0U; j < win; j++)
+            {
+                w[j] = (i >= j) ? s_lane[lane][i - j] : s_lane[lane][0];
+            }
+            qsort(w, win, sizeof(w[0]), Check_CmpU16);
+            s_ref[lane][i] = w[win / 2U];
+        }
+    }
+
+    Check_Compare("median", CHECK_LEN);
+}
+
+/*==================================================================================================
+* MAIN FUNCTION
+==================================================================================================*/
+int main(void)
+{
+    static const uint16_t alphas[] = { 1U, 4096U, 16384U, 32767U };
+    uint32_t              k;
+    uint32_t              stride;
+    uint32_t              p;
+    uint32_t              runs = 0U;
+
+    srand(1U);
+
+    for (k = 0U; k < CHECK_STREAMS; k++)
+    {
+        for (stride = 1U; stride <= CHECK_MAX_STRIDE; stride++)
+        {
+            Check_MakeStream(k, stride);
+
+            for (p = 1U; p <= DSP_MAVG_MAX_LEN; p <<= 1U)
+            {
+                Check_MovAvg(p, stride);
+                runs++;
+            }
+            for (p = 0U; p < (sizeof(alphas) / sizeof(alphas[0])); p++)
+            {
+                Check_Iir(alphas[p], stride);
+                runs++;
+            }
+            for (p = 2U; p <= DSP_CIC_MAX_DECIMATION; p <<= 1U)
+            {
+                Check_Cic(p, stride);
+                runs++;
+            }
+            for (p = 3U; p <= DSP_MEDIAN_MAX_N; p += 2U)
+            {
+                Check_Median(p, stride);
+                runs++;
+            }
+        }
+    }
+
+    printf("%u filter runs x %u sample pairs: %u mismatches\n",
+           (unsigned)runs, (unsigned)CHECK_LEN, (unsigned)s_errors);
+    printf("%s\n", (s_errors == 0U) ? "PASS" : "FAIL");
+
+    return (s_errors == 0U) ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file Debounce.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Timer driven input debouncer for S32K144
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#include "Driver_GPIO.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* Ports the debouncer can sample (PTA..PTE) */
+#define DEBOUNCE_MAX_PORTS            (5U)
+
+/* Event queue length (power of two, at most 128) */
+#define DEBOUNCE_QUEUE_SIZE           (16U)
+
+/* A pin changes state after this many equal samples (2-bit vertical counter) */
+#define DEBOUNCE_SAMPLES              (4U)
+
+/* Event kinds */
+#define DEBOUNCE_EVENT_RELEASE        (0U)
+#define DEBOUNCE_EVENT_PRESS          (1U)
+
+/*==================================================================================================
+* TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief One debounced input change
+ */
+typedef struct {
+    ARM_GPIO_Pin_t pin;       /* Virtual pin */
+    uint8_t        event;     /* DEBOUNCE_EVENT_PRESS / DEBOUNCE_EVENT_RELEASE */
+} Debounce_Event_t;
+
+/*==================================================================================================
+* FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief Add an input pin to the debouncer.
+ *
+ * The pin must already be configured as an input. Call before Debounce_Init();
+ * the current level is taken as the initial state, so no event is reported for it.
+ *
+ * @param pin GPIO Pin
+ * @param activeLow 1: pin reads 0 when pressed (pull-up, button to GND)
+ * @return int32_t Execution status
+ */
+int32_t Debounce_AddPin(ARM_GPIO_Pin_t pin, uint8_t activeLow);
+
+/**
+ * @brief Start the LPTMR0 sample tick.
+ *
+ * LPTMR0 runs from the 1 kHz LPO, so the tick does not depend on the core clock.
+ * A change is reported after DEBOUNCE_SAMPLES * period_ms of stable input.
+ *
+ * @param period_ms Sample period in ms (1..65535)
+ * @return int32_t Execution status
+ */
+int32_t Debounce_Init(uint32_t period_ms);
+
+/**
+ * @brief Take one event from the queue.
+ *
+ * @param ev Output event
+ * @return uint8_t 1: event returned, 0: queue empty
+ */
+uint8_t Debounce_GetEvent(Debounce_Event_t *ev);
+
+/**
+ * @brief Debounced state of a pin.
+ *
+ * @param pin GPIO Pin
+ * @return uint8_t 1: pressed, 0: released or pin not debounced
+ */
+uint8_t Debounce_IsPressed(ARM_GPIO_Pin_t pin);
+
+/**
+ * @brief Number of events lost because the queue was full.
+ *
+ * @return uint32_t Dropped event count
+ */
+uint32_t Debounce_GetDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBOUNCE_H_ */
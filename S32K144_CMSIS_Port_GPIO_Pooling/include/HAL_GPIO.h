@@ -32,6 +32,9 @@ extern "C" {
 /* Maximum number of virtual pins supported by the HAL mapping table. */
 #define HAL_GPIO_MAX_PINS             (64U)
 
+/* Maximum number of ports one pin group may span (PTA..PTE). */
+#define HAL_GPIO_GROUP_MAX_PORTS      (5U)
+
 /*==================================================================================================
 * TYPEDEFS
 ==================================================================================================*/
@@ -52,6 +55,17 @@ typedef struct
  */
 typedef ARM_GPIO_SignalEvent_t HAL_GPIO_Callback_t;
 
+/**
+ * @brief Group of virtual pins resolved to one bit mask per port
+ *
+ */
+typedef struct
+{
+    GPIO_Type *gpio[HAL_GPIO_GROUP_MAX_PORTS];   /* Ports used by the group */
+    uint32_t   mask[HAL_GPIO_GROUP_MAX_PORTS];   /* Pins of the group in gpio[i] */
+    uint8_t    ports;                            /* Number of entries used */
+} HAL_GPIO_Group_t;
+
 /*==================================================================================================
 * FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -94,8 +108,12 @@ int32_t HAL_GPIO_SetPullResistor(ARM_GPIO_Pin_t pin, ARM_GPIO_PULL_RESISTOR resi
 /**
  * @brief Set GPIO Event Trigger.
  *
+ * Programs PORT PCR IRQC and enables the port interrupt in the NVIC. The
+ * callback given to Setup() runs in interrupt context. Only PORTC and PORTD
+ * pins have a handler; other pins return ARM_DRIVER_ERROR_UNSUPPORTED.
+ *
  * @param pin GPIO Pin
- * @param trigger Event trigger to set (rising edge, falling edge, etc.)
+ * @param trigger Event trigger to set (none, rising, falling or either edge)
  * @return int32_t Execution status
  */
 int32_t HAL_GPIO_SetEventTrigger(ARM_GPIO_Pin_t pin, ARM_GPIO_EVENT_TRIGGER trigger);
@@ -116,6 +134,62 @@ void HAL_GPIO_Write(ARM_GPIO_Pin_t pin, uint32_t val);
  */
 uint32_t HAL_GPIO_Read(ARM_GPIO_Pin_t pin);
 
+/**
+ * @brief Get the port and bit mask of a virtual pin.
+ *
+ * @param pin GPIO Pin
+ * @param gpio Output: GPIO port of the pin
+ * @return uint32_t Bit mask of the pin in its port (0 if the pin is invalid)
+ */
+uint32_t HAL_GPIO_GetPinMask(ARM_GPIO_Pin_t pin, GPIO_Type **gpio);
+
+/**
+ * @brief Set and clear several pins of one port (one PSOR and one PCOR write).
+ *
+ * Pins in both masks end up cleared.
+ *
+ * @param gpio GPIO port
+ * @param set_mask Pins to drive high
+ * @param clear_mask Pins to drive low
+ */
+void HAL_GPIO_SetOutputMask(GPIO_Type *gpio, uint32_t set_mask, uint32_t clear_mask);
+
+/**
+ * @brief Write all output pins of one port (one PDOR write).
+ *
+ * @param gpio GPIO port
+ * @param value Output level of every pin
+ */
+void HAL_GPIO_WritePort(GPIO_Type *gpio, uint32_t value);
+
+/**
+ * @brief Read all input pins of one port (one PDIR read).
+ *
+ * @param gpio GPIO port
+ * @return uint32_t Input level of every pin
+ */
+uint32_t HAL_GPIO_GetInputPort(GPIO_Type *gpio);
+
+/**
+ * @brief Resolve a list of virtual pins to per-port masks (once, at setup).
+ *
+ * @param group Output group
+ * @param pins Virtual pins
+ * @param count Number of pins
+ * @return int32_t ARM_DRIVER_OK; ARM_DRIVER_ERROR_PARAMETER if group or pins is
+ *         NULL or the pins span more than HAL_GPIO_GROUP_MAX_PORTS ports;
+ *         ARM_GPIO_ERROR_PIN if a pin is invalid (the group is left empty)
+ */
+int32_t HAL_GPIO_GroupInit(HAL_GPIO_Group_t *group, const ARM_GPIO_Pin_t *pins, uint32_t count);
+
+/**
+ * @brief Drive every pin of a group to the same level (one write per port).
+ *
+ * @param group Resolved group
+ * @param val Value to write (0 or 1)
+ */
+void HAL_GPIO_GroupWrite(const HAL_GPIO_Group_t *group, uint32_t val);
+
 #ifdef __cplusplus
 }
 #endif
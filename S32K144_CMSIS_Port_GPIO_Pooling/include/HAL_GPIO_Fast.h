@@ -0,0 +1,69 @@
+/**
+ * @file HAL_GPIO_Fast.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Compile-time resolved GPIO access for constant virtual pins
+ * @version 0.1
+ * @date 2026-03-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HAL_GPIO_FAST_H_
+#define HAL_GPIO_FAST_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#include "S32K144.h"
+#include "HAL_GPIO_Pins.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/*
+ * Every macro below folds to a constant for a constant pin (even at -O0):
+ * HAL_GPIO_FAST_SET(1U) is one store of (1 << 15) to PTD->PSOR. An unknown
+ * pin fails to compile. Pins chosen at run time keep using Driver_GPIO0.
+ */
+#define HAL_GPIO_FAST_IS_PIN(p, vpin, gpio, port, bit)    || ((p) == (vpin))
+#define HAL_GPIO_FAST_BIT_OF(p, vpin, gpio, port, bit)    | (((p) == (vpin)) ? (1UL << (bit)) : 0UL)
+#define HAL_GPIO_FAST_BASE_OF(p, vpin, gpio, port, bit)   | (((p) == (vpin)) ? (uint32_t)IP_##gpio##_BASE : 0UL)
+
+/* 1 if pin is in the table (integer constant expression) */
+#define HAL_GPIO_FAST_VALID(pin)      (0 HAL_GPIO_PIN_TABLE(HAL_GPIO_FAST_IS_PIN, (pin)))
+
+/* Bit mask of pin in its port */
+#define HAL_GPIO_FAST_MASK(pin)       (0UL HAL_GPIO_PIN_TABLE(HAL_GPIO_FAST_BIT_OF, (pin)))
+
+/* GPIO port of pin */
+#define HAL_GPIO_FAST_GPIO(pin)       ((GPIO_Type *)(0UL HAL_GPIO_PIN_TABLE(HAL_GPIO_FAST_BASE_OF, (pin))))
+
+#define HAL_GPIO_FAST_CHECK(pin)      _Static_assert(HAL_GPIO_FAST_VALID(pin), "GPIO pin not in HAL_GPIO_PIN_TABLE")
+
+/* Same check usable inside an expression: evaluates to 0 */
+#define HAL_GPIO_FAST_CHECK_EXPR(pin) (0U * (uint32_t)sizeof(struct { int pin_in_table : (HAL_GPIO_FAST_VALID(pin) ? 1 : -1); }))
+
+/* Drive pin high / low / invert: one store to PSOR / PCOR / PTOR */
+#define HAL_GPIO_FAST_SET(pin)        do { HAL_GPIO_FAST_CHECK(pin); HAL_GPIO_FAST_GPIO(pin)->PSOR = HAL_GPIO_FAST_MASK(pin); } while (0)
+#define HAL_GPIO_FAST_CLEAR(pin)      do { HAL_GPIO_FAST_CHECK(pin); HAL_GPIO_FAST_GPIO(pin)->PCOR = HAL_GPIO_FAST_MASK(pin); } while (0)
+#define HAL_GPIO_FAST_TOGGLE(pin)     do { HAL_GPIO_FAST_CHECK(pin); HAL_GPIO_FAST_GPIO(pin)->PTOR = HAL_GPIO_FAST_MASK(pin); } while (0)
+
+/* Same as HAL_GPIO_Write: val != 0 drives high */
+#define HAL_GPIO_FAST_WRITE(pin, val)                                                       \
+    do {                                                                                    \
+        HAL_GPIO_FAST_CHECK(pin);                                                           \
+        if (0U != (val)) {                                                                  \
+            HAL_GPIO_FAST_GPIO(pin)->PSOR = HAL_GPIO_FAST_MASK(pin);                        \
+        } else {                                                                            \
+            HAL_GPIO_FAST_GPIO(pin)->PCOR = HAL_GPIO_FAST_MASK(pin);                        \
+        }                                                                                   \
+    } while (0)
+
+/* Read pin (0 or 1): one load of PDIR */
+#define HAL_GPIO_FAST_READ(pin)       ((((HAL_GPIO_FAST_GPIO(pin)->PDIR & HAL_GPIO_FAST_MASK(pin)) != 0U) ? 1U : 0U) + \
+                                       HAL_GPIO_FAST_CHECK_EXPR(pin))
+
+#endif /* HAL_GPIO_FAST_H_ */
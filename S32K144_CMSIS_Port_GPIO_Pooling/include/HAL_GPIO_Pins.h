@@ -0,0 +1,30 @@
+/**
+ * @file HAL_GPIO_Pins.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Virtual pin table shared by the HAL mapping table and the inline fast path
+ * @version 0.1
+ * @date 2026-03-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HAL_GPIO_PINS_H_
+#define HAL_GPIO_PINS_H_
+
+/*==================================================================================================
+* PIN TABLE
+==================================================================================================*/
+/*
+ * One X(arg, vpin, GPIO, PORT, bit) entry per virtual pin. GPIO and PORT are the
+ * instance names without the IP_ prefix; arg is passed through unchanged so a
+ * user of the table can compare each vpin with a value.
+ */
+#define HAL_GPIO_PIN_TABLE(X, arg)                                       \
+    X(arg, 0U, PTD, PORTD,  0U)  /* LED xanh  - PTD0  */                 \
+    X(arg, 1U, PTD, PORTD, 15U)  /* LED do    - PTD15 */                 \
+    X(arg, 2U, PTD, PORTD, 16U)  /* LED xanhL - PTD16 */                 \
+    X(arg, 3U, PTC, PORTC, 12U)  /* Nut BTN0  - PTC12 */                 \
+    X(arg, 4U, PTC, PORTC, 13U)  /* Nut BTN1  - PTC13 */
+
+#endif /* HAL_GPIO_PINS_H_ */
@@ -0,0 +1,292 @@
+/**
+ * @file Debounce.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Timer driven input debouncer for S32K144
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include "Debounce.h"
+#include "HAL_GPIO.h"
+#include "NVIC.h"
+#include "S32K144.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+#define DEBOUNCE_QUEUE_MASK           (DEBOUNCE_QUEUE_SIZE - 1U)
+
+#define DEBOUNCE_LPTMR_PCS_LPO1K      (1U)       /* LPTMR PSR PCS: 1 kHz LPO */
+#define DEBOUNCE_LPTMR_MAX_PERIOD     (0xFFFFU)  /* 16-bit compare register */
+#define DEBOUNCE_IRQ_PRIORITY         (8U)       /* Priority level: 0..15 (implemented in MSBs) */
+
+/*==================================================================================================
+* TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief Debounce state of one GPIO port (up to 32 pins in parallel)
+ *
+ * Each pin has a 2-bit counter split over ct0/ct1 (bit n of both words is the
+ * counter of pin n). The counter restarts while the sample equals the
+ * debounced state and counts down while it differs; the state flips when it wraps.
+ */
+typedef struct {
+    GPIO_Type *gpio;
+    uint32_t   mask;          /* Debounced pins */
+    uint32_t   invert;        /* Active-low pins */
+    uint32_t   state;         /* Debounced state, 1 = pressed */
+    uint32_t   ct0;
+    uint32_t   ct1;
+    uint8_t    vpin[32U];     /* Virtual pin of each port bit */
+} Debounce_Port_t;
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+static Debounce_Port_t  s_ports[DEBOUNCE_MAX_PORTS];
+static uint32_t         s_portCount;
+
+/* Single producer (tick) / single consumer (main) queue, free running indexes */
+static Debounce_Event_t s_queue[DEBOUNCE_QUEUE_SIZE];
+static volatile uint8_t s_head;
+static volatile uint8_t s_tail;
+static volatile uint32_t s_dropped;
+
+/*==================================================================================================
+* PROTOTYPES
+==================================================================================================*/
+void LPTMR0_IRQHandler(void);
+
+/*==================================================================================================
+* STATIC FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Find the state of a port, optionally adding it
+ *
+ * @param gpio GPIO port
+ * @param add 1: add the port when it is not known yet
+ * @return Debounce_Port_t* Port state or NULL
+ */
+static Debounce_Port_t *Debounce_FindPort(const GPIO_Type *gpio, uint8_t add)
+{
+    uint32_t i;
+
+    for (i = 0U; i < s_portCount; i++) {
+        if (s_ports[i].gpio == gpio) {
+            return &s_ports[i];
+        }
+    }
+
+    if ((0U == add) || (s_portCount >= DEBOUNCE_MAX_PORTS)) {
+        return NULL;
+    }
+
+    s_ports[s_portCount].gpio = (GPIO_Type *)gpio;
+    s_ports[s_portCount].ct0  = 0xFFFFFFFFUL;
+    s_ports[s_portCount].ct1  = 0xFFFFFFFFUL;
+    s_portCount++;
+
+    return &s_ports[s_portCount - 1U];
+}
+
+/**
+ * @brief Queue one event (tick context)
+ *
+ * @param pin Virtual pin
+ * @param event DEBOUNCE_EVENT_*
+ */
+static void Debounce_Push(uint8_t pin, uint8_t event)
+{
+    uint8_t head = s_head;
+
+    if ((uint8_t)(head - s_tail) >= DEBOUNCE_QUEUE_SIZE) {
+        s_dropped++;
+        return;
+    }
+
+    s_queue[head & DEBOUNCE_QUEUE_MASK].pin   = pin;
+    s_queue[head & DEBOUNCE_QUEUE_MASK].event = event;
+    s_head = (uint8_t)(head + 1U);
+}
+
+/**
+ * @brief Sample every port once and run the vertical counters
+ *
+ * One PDIR read and a handful of bitwise operations per port; the event loop
+ * only runs for pins whose debounced state changed on this tick.
+ */
+static void Debounce_Tick(void)
+{
+    Debounce_Port_t *p;
+    uint32_t         i;
+    uint32_t         delta;
+    uint32_t         toggle;
+    uint32_t         bit;
+
+    for (i = 0U; i < s_portCount; i++) {
+        p = &s_ports[i];
+
+        delta  = ((p->gpio->PDIR ^ p->invert) & p->mask) ^ p->state;
+        p->ct0 = ~(p->ct0 & delta);
+        p->ct1 = p->ct0 ^ (p->ct1 & delta);
+        toggle = delta & p->ct0 & p->ct1;
+        p->state ^= toggle;
+
+        while (0U != toggle) {
+            bit = (uint32_t)__builtin_ctz(toggle);
+            Debounce_Push(p->vpin[bit],
+                          (0U != (p->state & (1UL << bit))) ? DEBOUNCE_EVENT_PRESS : DEBOUNCE_EVENT_RELEASE);
+            toggle &= toggle - 1U;
+        }
+    }
+}
+
+/*==================================================================================================
+* INTERRUPT HANDLER
+==================================================================================================*/
+/**
+ * @brief LPTMR0 interrupt: debounce sample tick
+ *
+ */
+void LPTMR0_IRQHandler(void)
+{
+    /* Clear compare flag (write-1-to-clear) */
+    IP_LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+
+    Debounce_Tick();
+}
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Add an input pin to the debouncer.
+ *
+ * @param pin Virtual pin number
+ * @param activeLow 1: pressed reads 0
+ * @return int32_t Error code or ARM_DRIVER_OK
+ */
+int32_t Debounce_AddPin(ARM_GPIO_Pin_t pin, uint8_t activeLow)
+{
+    GPIO_Type       *gpio = NULL;
+    Debounce_Port_t *p;
+    uint32_t         mask;
+    uint32_t         level;
+
+    mask = HAL_GPIO_GetPinMask(pin, &gpio);
+    if (0U == mask) {
+        return ARM_GPIO_ERROR_PIN;
+    }
+
+    p = Debounce_FindPort(gpio, 1U);
+    if (NULL == p) {
+        return ARM_DRIVER_ERROR;
+    }
+
+    if (0U != activeLow) {
+        p->invert |= mask;
+    }
+    else {
+        p->invert &= ~mask;
+    }
+
+    level = (gpio->PDIR ^ p->invert) & mask;
+
+    p->mask  |= mask;
+    p->state  = (p->state & ~mask) | level;
+    p->vpin[__builtin_ctz(mask)] = (uint8_t)pin;
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+ * @brief Start the LPTMR0 sample tick.
+ *
+ * @param period_ms Sample period in ms
+ * @return int32_t Error code or ARM_DRIVER_OK
+ */
+int32_t Debounce_Init(uint32_t period_ms)
+{
+    uint32_t irqn = (uint32_t)LPTMR0_IRQn;
+
+    if ((0U == period_ms) || (period_ms > DEBOUNCE_LPTMR_MAX_PERIOD)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    IP_PCC->PCCn[PCC_LPTMR0_INDEX] |= PCC_PCCn_CGC_MASK;
+
+    /* Stop the timer before changing PSR/CMR */
+    IP_LPTMR0->CSR = 0U;
+
+    /* LPO 1 kHz, prescaler bypassed: one count per ms */
+    IP_LPTMR0->PSR = LPTMR_PSR_PCS(DEBOUNCE_LPTMR_PCS_LPO1K) | LPTMR_PSR_PBYP_MASK;
+    IP_LPTMR0->CMR = LPTMR_CMR_COMPARE(period_ms - 1U);
+
+    MY_NVIC->ICPR[irqn / 32U] = (1UL << (irqn % 32U));
+    MY_NVIC->IP[irqn] = (uint8_t)((uint32_t)DEBOUNCE_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS));
+    MY_NVIC->ISER[irqn / 32U] = (1UL << (irqn % 32U));
+
+    /* Time counter mode, reset on compare, interrupt on compare */
+    IP_LPTMR0->CSR = LPTMR_CSR_TCF_MASK | LPTMR_CSR_TIE_MASK;
+    IP_LPTMR0->CSR |= LPTMR_CSR_TEN_MASK;
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+ * @brief Take one event from the queue.
+ *
+ * @param ev Output event
+ * @return uint8_t 1: event returned, 0: queue empty
+ */
+uint8_t Debounce_GetEvent(Debounce_Event_t *ev)
+{
+    uint8_t tail = s_tail;
+
+    if ((NULL == ev) || (tail == s_head)) {
+        return 0U;
+    }
+
+    *ev    = s_queue[tail & DEBOUNCE_QUEUE_MASK];
+    s_tail = (uint8_t)(tail + 1U);
+
+    return 1U;
+}
+
+/**
+ * @brief Debounced state of a pin.
+ *
+ * @param pin Virtual pin number
+ * @return uint8_t 1: pressed, 0: released
+ */
+uint8_t Debounce_IsPressed(ARM_GPIO_Pin_t pin)
+{
+    GPIO_Type       *gpio = NULL;
+    Debounce_Port_t *p;
+    uint32_t         mask;
+
+    mask = HAL_GPIO_GetPinMask(pin, &gpio);
+    p    = (0U != mask) ? Debounce_FindPort(gpio, 0U) : NULL;
+
+    if ((NULL == p) || (0U == (p->mask & mask))) {
+        return 0U;
+    }
+
+    return (0U != (p->state & mask)) ? 1U : 0U;
+}
+
+/**
+ * @brief Number of events lost because the queue was full.
+ *
+ * @return uint32_t Dropped event count
+ */
+uint32_t Debounce_GetDropped(void)
+{
+    return s_dropped;
+}
@@ -13,23 +13,51 @@
 * INCLUDES
 ==================================================================================================*/
 #include "HAL_GPIO.h"
+#include "HAL_GPIO_Pins.h"
+#include "NVIC.h"
 #include "S32K144.h"
 
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* One mapping table entry from a HAL_GPIO_PIN_TABLE row */
+#define HAL_GPIO_MAP_ENTRY(arg, vpin, gpio, port, bit)   [vpin] = { IP_##gpio, IP_##port, bit },
+
+/* PORT_PCR_IRQC values */
+#define HAL_GPIO_IRQC_DISABLED        (0x0U)
+#define HAL_GPIO_IRQC_RISING          (0x9U)
+#define HAL_GPIO_IRQC_FALLING         (0xAU)
+#define HAL_GPIO_IRQC_EITHER          (0xBU)
+
+/* Ports with a pin detect interrupt handled here: PORTC, PORTD */
+#define HAL_GPIO_IRQ_PORTS            (2U)
+#define HAL_GPIO_IRQ_PORT_C           (0U)
+#define HAL_GPIO_IRQ_PORT_D           (1U)
+#define HAL_GPIO_PORT_IRQ_PRIORITY    (6U)   /* Priority level: 0..15 (implemented in MSBs) */
+
 /*==================================================================================================
 * VARIABLES
 ==================================================================================================*/
-/* Virtual pin mapping table */
+/* Virtual pin mapping table (pins listed in HAL_GPIO_Pins.h) */
 static const pin_map_t s_pinMap[HAL_GPIO_MAX_PINS] = {
-    [0] = { IP_PTD, IP_PORTD,  0 },  /* LED xanh  - PTD0  */
-    [1] = { IP_PTD, IP_PORTD, 15 },  /* LED đỏ    - PTD15 */
-    [2] = { IP_PTD, IP_PORTD, 16 },  /* LED xanhL - PTD16 */
-    [3] = { IP_PTC, IP_PORTC, 12 },  /* Nút BTN0   - PTC12 */
-    [4] = { IP_PTC, IP_PORTC, 13 },  /* Nút BTN1   - PTC13 */
+    HAL_GPIO_PIN_TABLE(HAL_GPIO_MAP_ENTRY, 0)
 };
 
 /* Callback functions for GPIO events */
 static HAL_GPIO_Callback_t s_gpioCallbacks[HAL_GPIO_MAX_PINS];
 
+/* Event reported for each pin (ARM_GPIO_EVENT_*), 0 = interrupt disabled */
+static uint8_t s_gpioEvents[HAL_GPIO_MAX_PINS];
+
+/* Virtual pin + 1 of each port bit with an interrupt enabled, per IRQ port (0 = none) */
+static uint8_t s_irqVpin[HAL_GPIO_IRQ_PORTS][32U];
+
+/*==================================================================================================
+* PROTOTYPES
+==================================================================================================*/
+void PORTC_IRQHandler(void);
+void PORTD_IRQHandler(void);
+
 /**
  * @brief Get the pin mapping for a virtual pin
  *
@@ -62,6 +90,56 @@ static void HAL_GPIO_EnablePortClock(const pin_map_t *map)
     }
 }
 
+/**
+ * @brief Get the pin detect interrupt of a port
+ *
+ * @param port PORT base
+ * @param irqn Output: NVIC interrupt number
+ * @return uint32_t Index in s_irqVpin or HAL_GPIO_IRQ_PORTS if the port has no handler here
+ */
+static uint32_t HAL_GPIO_GetIrqPort(const PORT_Type *port, uint32_t *irqn)
+{
+    uint32_t index = HAL_GPIO_IRQ_PORTS;
+
+    if (port == IP_PORTC) {
+        index = HAL_GPIO_IRQ_PORT_C;
+        *irqn = (uint32_t)PORTC_IRQn;
+    } else if (port == IP_PORTD) {
+        index = HAL_GPIO_IRQ_PORT_D;
+        *irqn = (uint32_t)PORTD_IRQn;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Dispatch the pending pin interrupts of one port
+ *
+ * ISFR is read once and the flags found are cleared with a single write,
+ * then each flagged pin's callback runs.
+ *
+ * @param port PORT base
+ * @param index Index in s_irqVpin
+ */
+static void HAL_GPIO_DispatchPort(PORT_Type *port, uint32_t index)
+{
+    uint32_t flags = port->ISFR;
+    uint32_t bit;
+    uint8_t  entry;
+
+    port->ISFR = flags;   /* w1c */
+
+    while (0U != flags) {
+        bit    = (uint32_t)__builtin_ctz(flags);
+        flags &= flags - 1U;
+        entry  = s_irqVpin[index][bit];
+
+        if ((0U != entry) && (NULL != s_gpioCallbacks[entry - 1U])) {
+            s_gpioCallbacks[entry - 1U](entry - 1U, s_gpioEvents[entry - 1U]);
+        }
+    }
+}
+
 /*==================================================================================================
 * API HALs
 ===================================================================================================*/
@@ -195,20 +273,58 @@ int32_t HAL_GPIO_SetEventTrigger(ARM_GPIO_Pin_t pin, ARM_GPIO_EVENT_TRIGGER trig
         return ARM_GPIO_ERROR_PIN;
     }
 
-    uint32_t pcr = map->port->PCR[map->pin];
-
-    pcr &= ~PORT_PCR_IRQC_MASK;
+    uint32_t irqn  = 0U;
+    uint32_t index = HAL_GPIO_GetIrqPort(map->port, &irqn);
+    uint32_t irqc;
+    uint8_t  event;
 
     switch (trigger)
     {
     case ARM_GPIO_TRIGGER_NONE:
+        irqc  = HAL_GPIO_IRQC_DISABLED;
+        event = 0U;
+        break;
+    case ARM_GPIO_TRIGGER_RISING_EDGE:
+        irqc  = HAL_GPIO_IRQC_RISING;
+        event = (uint8_t)ARM_GPIO_EVENT_RISING_EDGE;
+        break;
+    case ARM_GPIO_TRIGGER_FALLING_EDGE:
+        irqc  = HAL_GPIO_IRQC_FALLING;
+        event = (uint8_t)ARM_GPIO_EVENT_FALLING_EDGE;
+        break;
+    case ARM_GPIO_TRIGGER_EITHER_EDGE:
+        /* ISFR does not tell which edge it was */
+        irqc  = HAL_GPIO_IRQC_EITHER;
+        event = (uint8_t)ARM_GPIO_EVENT_EITHER_EDGE;
         break;
     default:
         return ARM_DRIVER_ERROR_PARAMETER;
     }
 
+    if ((HAL_GPIO_IRQ_PORTS == index) && (HAL_GPIO_IRQC_DISABLED != irqc)) {
+        /* No IRQ handler for this port */
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+
+    uint32_t pcr = map->port->PCR[map->pin];
+
+    pcr &= ~(PORT_PCR_IRQC_MASK | PORT_PCR_ISF_MASK);
+    pcr |= PORT_PCR_IRQC(irqc);
+
+    s_gpioEvents[pin] = event;
+    if (HAL_GPIO_IRQ_PORTS != index) {
+        s_irqVpin[index][map->pin] = (HAL_GPIO_IRQC_DISABLED != irqc) ? (uint8_t)(pin + 1U) : 0U;
+    }
+
+    /* Drop an edge latched before the trigger was chosen */
+    map->port->ISFR = (1UL << map->pin);
     map->port->PCR[map->pin] = pcr;
 
+    if (HAL_GPIO_IRQC_DISABLED != irqc) {
+        MY_NVIC->IP[irqn] = (uint8_t)((uint32_t)HAL_GPIO_PORT_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS));
+        MY_NVIC->ISER[irqn / 32U] = (1UL << (irqn % 32U));
+    }
+
     return ARM_DRIVER_OK;
 }
 
@@ -226,9 +342,9 @@ void HAL_GPIO_Write(ARM_GPIO_Pin_t pin, uint32_t val)
     }
 
     if (val) {
-        map->gpio -> PTOR = (1UL << map->pin);
+        map->gpio -> PSOR = (1UL << map->pin);
     } else {
-        map->gpio -> PTOR = (1UL << map->pin);
+        map->gpio -> PCOR = (1UL << map->pin);
     }
 }
 
@@ -248,3 +364,146 @@ uint32_t HAL_GPIO_Read(ARM_GPIO_Pin_t pin)
     uint32_t pdir = map->gpio->PDIR;
     return (pdir >> map->pin) & 1UL;
 }
+
+/**
+ * @brief Get port and bit mask of a virtual pin
+ *
+ * @param pin Virtual pin number
+ * @param gpio Output: GPIO port of the pin
+ * @return uint32_t Pin mask or 0 if invalid
+ */
+uint32_t HAL_GPIO_GetPinMask(ARM_GPIO_Pin_t pin, GPIO_Type **gpio)
+{
+    const pin_map_t *map = HAL_GPIO_GetMap(pin);
+    if ((NULL == map) || (NULL == gpio)) {
+        return 0U;
+    }
+
+    *gpio = map->gpio;
+    return (1UL << map->pin);
+}
+
+/**
+ * @brief Set and clear pins of one port
+ *
+ * @param gpio GPIO port
+ * @param set_mask Pins to drive high
+ * @param clear_mask Pins to drive low (wins over set_mask)
+ */
+void HAL_GPIO_SetOutputMask(GPIO_Type *gpio, uint32_t set_mask, uint32_t clear_mask)
+{
+    gpio->PSOR = set_mask & ~clear_mask;
+    gpio->PCOR = clear_mask;
+}
+
+/**
+ * @brief Write a whole port
+ *
+ * @param gpio GPIO port
+ * @param value Output levels
+ */
+void HAL_GPIO_WritePort(GPIO_Type *gpio, uint32_t value)
+{
+    gpio->PDOR = value;
+}
+
+/**
+ * @brief Read a whole port
+ *
+ * @param gpio GPIO port
+ * @return uint32_t Input levels
+ */
+uint32_t HAL_GPIO_GetInputPort(GPIO_Type *gpio)
+{
+    return gpio->PDIR;
+}
+
+/**
+ * @brief Resolve virtual pins to per-port masks
+ *
+ * @param group Output group
+ * @param pins Virtual pins
+ * @param count Number of pins
+ * @return int32_t ARM_DRIVER_OK, ARM_DRIVER_ERROR_PARAMETER or ARM_GPIO_ERROR_PIN
+ */
+int32_t HAL_GPIO_GroupInit(HAL_GPIO_Group_t *group, const ARM_GPIO_Pin_t *pins, uint32_t count)
+{
+    const pin_map_t *map;
+    uint32_t         i;
+    uint8_t          p;
+
+    if ((NULL == group) || (NULL == pins)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    group->ports = 0U;
+
+    for (i = 0U; i < count; i++) {
+        map = HAL_GPIO_GetMap(pins[i]);
+        if (NULL == map) {
+            group->ports = 0U;
+            return ARM_GPIO_ERROR_PIN;
+        }
+
+        /* Find the port entry, add one if this port is new */
+        p = 0U;
+        while ((p < group->ports) && (group->gpio[p] != map->gpio)) {
+            p++;
+        }
+
+        if (p == group->ports) {
+            if (p >= HAL_GPIO_GROUP_MAX_PORTS) {
+                group->ports = 0U;
+                return ARM_DRIVER_ERROR_PARAMETER;
+            }
+
+            group->gpio[p] = map->gpio;
+            group->mask[p] = 0U;
+            group->ports++;
+        }
+
+        group->mask[p] |= (1UL << map->pin);
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+ * @brief Drive every pin of a group to the same level
+ *
+ * @param group Resolved group
+ * @param val Value to write (0 or 1)
+ */
+void HAL_GPIO_GroupWrite(const HAL_GPIO_Group_t *group, uint32_t val)
+{
+    uint8_t p;
+
+    for (p = 0U; p < group->ports; p++) {
+        if (val) {
+            group->gpio[p]->PSOR = group->mask[p];
+        } else {
+            group->gpio[p]->PCOR = group->mask[p];
+        }
+    }
+}
+
+/*==================================================================================================
+* IRQ HANDLERS
+==================================================================================================*/
+/**
+ * @brief Port C pin detect interrupt
+ *
+ */
+void PORTC_IRQHandler(void)
+{
+    HAL_GPIO_DispatchPort(IP_PORTC, HAL_GPIO_IRQ_PORT_C);
+}
+
+/**
+ * @brief Port D pin detect interrupt
+ *
+ */
+void PORTD_IRQHandler(void)
+{
+    HAL_GPIO_DispatchPort(IP_PORTD, HAL_GPIO_IRQ_PORT_D);
+}
@@ -1,7 +1,7 @@
 /**
  * @file main.c
  * @author Dung Van Pham (dungpv00@gmail.com)
- * @brief Main file for GPIO polling example on S32K144 using CMSIS Driver
+ * @brief Main file for GPIO debounced button example on S32K144 using CMSIS Driver
  * @version 0.1
  * @date 2025-12-20
  *
@@ -15,16 +15,15 @@
 #include "S32K144.h"
 #include "device_registers.h"
 #include "Driver_GPIO.h"
+#include "HAL_GPIO.h"
+#include "HAL_GPIO_Fast.h"
+#include "Debounce.h"
+#include "DWT.h"
+#include "s32_core_cm4.h"
 
 /*==================================================================================================
 * DEFINES
 ==================================================================================================*/
-/* CPU clock frequency used for the rough DelayMs busy-wait.
- * WARNING: Must match the real core clock, otherwise delay will be incorrect.
- */
-#define CPU_CLOCK_FREQ                 (8000000UL)
-#define CYCLES_PER_MS                  (CPU_CLOCK_FREQ / 1000UL)
-
 /* Button logic:
  * With pull-up enabled and button wired to GND:
  * - Released: 1
@@ -32,6 +31,9 @@
  */
 #define BTN_PRESSED                    (0U)
 
+/* Debounce sample period: a press is reported after DEBOUNCE_SAMPLES * 5 ms = 20 ms */
+#define BUTTON_SAMPLE_MS               (5U)
+
 /* Virtual pin mapping (must match the mapping table in HAL_GPIO.c)
  * These numbers are NOT physical pins; they are "virtual IDs" that the HAL maps to real PORT/pin.
  */
@@ -47,24 +49,66 @@
 /* Driver instance implemented in Driver_GPIO.c */
 extern ARM_DRIVER_GPIO Driver_GPIO0;
 
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+/* Cycles for GPIO_COMPARE_WRITES writes of one pin, filled at startup (read with the debugger) */
+#define GPIO_COMPARE_WRITES            (16U)
+volatile uint32_t g_gpioCyclesDriver;      /* Driver_GPIO0.SetOutput       */
+volatile uint32_t g_gpioCyclesFast;        /* HAL_GPIO_FAST_WRITE          */
+
 /*==================================================================================================
 * FUNCTIONS
 ==================================================================================================*/
-static void DelayMs(uint32_t delay_in_ms)
+/**
+ * @brief Compare the cost of a pin write through the CMSIS driver and the inline fast path
+ *
+ * Writes the RED LED OFF level, so nothing visible changes.
+ */
+static void GpioCompareCycles(void)
 {
-    volatile uint32_t loop_count;
+    uint32_t start;
+    uint32_t i;
 
-    /* Busy-wait delay: approximate only.
-     * CYCLES_PER_MS depends on CPU_CLOCK_FREQ and compiler optimization.
-     */
-    while (delay_in_ms > 0U)
+    MY_DEMCR       |= MY_DEMCR_TRCENA_MASK;
+    MY_DWT->CTRL   |= MY_DWT_CTRL_CYCCNTENA_MASK;
+
+    start = MY_DWT->CYCCNT;
+    for (i = 0U; i < GPIO_COMPARE_WRITES; i++)
     {
-        delay_in_ms--;
+        Driver_GPIO0.SetOutput(LED_RED_PIN, 1U);
+    }
+    g_gpioCyclesDriver = MY_DWT->CYCCNT - start;
 
-        for (loop_count = 0U; loop_count < CYCLES_PER_MS; loop_count++)
-        {
-            __asm("nop");
-        }
+    start = MY_DWT->CYCCNT;
+    for (i = 0U; i < GPIO_COMPARE_WRITES; i++)
+    {
+        HAL_GPIO_FAST_WRITE(LED_RED_PIN, 1U);
+    }
+    g_gpioCyclesFast = MY_DWT->CYCCNT - start;
+}
+
+/**
+ * @brief The LED follows its button: pressed -> LED ON
+ *
+ * @param ev Debounced button event
+ */
+static void ButtonEvent(const Debounce_Event_t *ev)
+{
+    /* Active-low LED: ON = 0 */
+    uint8_t led_level = (DEBOUNCE_EVENT_PRESS == ev->event) ? 0U : 1U;
+
+    if (BUTTON_1_PIN == ev->pin)
+    {
+        HAL_GPIO_FAST_WRITE(LED_RED_PIN, led_level);
+    }
+    else if (BUTTON_2_PIN == ev->pin)
+    {
+        HAL_GPIO_FAST_WRITE(LED_GREEN_PIN, led_level);
+    }
+    else
+    {
+        /* Not a button */
     }
 }
 
@@ -106,65 +150,29 @@ int main(void)
     (void)Driver_GPIO0.SetDirection(BUTTON_2_PIN, ARM_GPIO_INPUT);
     (void)Driver_GPIO0.SetPullResistor(BUTTON_2_PIN, ARM_GPIO_PULL_UP);
 
+    GpioCompareCycles();
+
     /*--------------------------------------------------------------------------------------------
-    * MAIN LOOP (POLLING)
+    * BUTTON DEBOUNCE (LPTMR0 tick samples PORTC, no pin interrupts: raw edges bounce)
     *-------------------------------------------------------------------------------------------*/
-    while (1)
-    {
-        uint32_t btn_1;
-        uint32_t btn_2;
+    (void)Debounce_AddPin(BUTTON_1_PIN, 1U);
+    (void)Debounce_AddPin(BUTTON_2_PIN, 1U);
+    (void)Debounce_Init(BUTTON_SAMPLE_MS);
 
-        /* Read current button states */
-        btn_1 = Driver_GPIO0.GetInput(BUTTON_1_PIN);
-        btn_2 = Driver_GPIO0.GetInput(BUTTON_2_PIN);
+    ENABLE_INTERRUPTS();
 
-        /*----------------------------------------------------------------------------------------
-        * Button 1 -> RED LED control (with simple debounce)
-        *---------------------------------------------------------------------------------------*/
-        if (BTN_PRESSED == btn_1)
-        {
-            /* Debounce delay */
-            DelayMs(20U);
-
-            /* NOTE:
-             * This code reuses the old btn_1 value; it should read again after the delay
-             * if you want a real debounce check. Kept as-is to match your structure.
-             */
-
-            if (BTN_PRESSED == btn_1)
-            {
-                /* Pressed -> turn ON RED LED (active-low should be 0).
-                 * WARNING: Your original code writes 1U but comments say 0 = LED on.
-                 */
-                (void)Driver_GPIO0.SetOutput(LED_RED_PIN, 0U);        /* 0 = LED ON */
-            }
-        }
-        else
-        {
-            /* Not pressed -> optionally turn OFF LED */
-            (void)Driver_GPIO0.SetOutput(LED_RED_PIN, 1U);            /* 1 = LED OFF */
-        }
-
-        /*----------------------------------------------------------------------------------------
-        * Button 2 -> GREEN LED control (with simple debounce)
-        *---------------------------------------------------------------------------------------*/
-        if (BTN_PRESSED == btn_2)
-        {
-            DelayMs(20U);
+    /*--------------------------------------------------------------------------------------------
+    * MAIN LOOP (HANDLE QUEUED BUTTON EVENTS, SLEEP UNTIL THE NEXT TICK)
+    *-------------------------------------------------------------------------------------------*/
+    while (1)
+    {
+        Debounce_Event_t ev;
 
-            /* Same debounce note as above: should read again after delay. */
-            if (btn_2 == BTN_PRESSED)
-            {
-                (void)Driver_GPIO0.SetOutput(LED_GREEN_PIN, 0U);      /* 0 = LED ON */
-            }
-        }
-        else
+        while (0U != Debounce_GetEvent(&ev))
         {
-            (void)Driver_GPIO0.SetOutput(LED_GREEN_PIN, 1U);          /* 1 = LED OFF */
+            ButtonEvent(&ev);
         }
 
-        /* Slow down polling loop */
-        DelayMs(100U);
+        STANDBY();
     }
 }
-
@@ -14,12 +14,14 @@
 ==================================================================================================*/
 #include <HAL_USART.h>
 #include "S32K144.h"
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
 ==================================================================================================*/
 #define CLEAR_LPUART_STAT    (0xFFFFFFFFUL)
-#define HAL_UART_RX_TIMEOUT_LOOP   (1000000U)
+#define HAL_UART_RX_TIMEOUT_MS     (100U)   /* Max wait for each received byte */
+#define HAL_UART_TX_TIMEOUT_MS     (10U)    /* Max wait for TX room (one frame at 9600 baud is ~1 ms) */
 
 /*==================================================================================================
 * VARIABLES
@@ -323,8 +325,9 @@ int32_t HAL_ARM_UART_PowerControl(HAL_UART_PowerState_t power_state)
  */
 int32_t HAL_ARM_USART_Send(const uint8_t *data, uint32_t num)
 {
-    int32_t  result = ARM_DRIVER_OK;
-    uint32_t i      = 0U;
+    int32_t         result = ARM_DRIVER_OK;
+    uint32_t        i      = 0U;
+    Time_Deadline_t deadline;
 
     if ((NULL == data) || (0U == num))
     {
@@ -349,9 +352,20 @@ int32_t HAL_ARM_USART_Send(const uint8_t *data, uint32_t num)
 
         for (i = 0U; i < num; i++)
         {
+            deadline = Time_Deadline(HAL_UART_TX_TIMEOUT_MS);
+
             while ((IP_LPUART1->STAT & LPUART_STAT_TDRE_MASK) == 0U)
             {
-                /* busy wait */
+                if (0U != Time_Expired(deadline))
+                {
+                    result = ARM_DRIVER_ERROR_TIMEOUT;
+                    break;
+                }
+            }
+
+            if (ARM_DRIVER_OK != result)
+            {
+                break;
             }
 
             IP_LPUART1->DATA = (uint32_t)data[i];
@@ -373,9 +387,9 @@ int32_t HAL_ARM_USART_Send(const uint8_t *data, uint32_t num)
  */
 int32_t HAL_ARM_USART_Receive(uint8_t *data, uint32_t num)
 {
-    int32_t  result      = ARM_DRIVER_OK;
-    uint32_t i           = 0U;
-    uint32_t timeout_cnt = 0U;
+    int32_t         result = ARM_DRIVER_OK;
+    uint32_t        i      = 0U;
+    Time_Deadline_t deadline;
 
     if ((NULL == data) || (0U == num))
     {
@@ -400,7 +414,7 @@ int32_t HAL_ARM_USART_Receive(uint8_t *data, uint32_t num)
 
         for (i = 0U; i < num; i++)
         {
-            timeout_cnt = 0U;
+            deadline = Time_Deadline(HAL_UART_RX_TIMEOUT_MS);
 
             /* Wait for receive data ready */
             while ((IP_LPUART1->STAT & LPUART_STAT_RDRF_MASK) == 0U)
@@ -414,8 +428,7 @@ int32_t HAL_ARM_USART_Receive(uint8_t *data, uint32_t num)
                     break;
                 }
 
-                timeout_cnt++;
-                if (timeout_cnt >= HAL_UART_RX_TIMEOUT_LOOP)
+                if (0U != Time_Expired(deadline))
                 {
                     result = ARM_DRIVER_ERROR_TIMEOUT;
                     break;
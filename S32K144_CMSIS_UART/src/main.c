@@ -17,6 +17,7 @@
 #include "Driver_USART.h"
 #include "Driver_GPIO.h"
 #include "app.h"
+#include "TimeBase.h"
 
 /*============================================================================
  * DEFINES
@@ -56,9 +57,14 @@ void WDOG_disable (void){
  */
 static void App_InitClock(void)
 {
-    SOSC_init_8MHz();
-    SPLL_init_160MHz();
-    NormalRUNmode_80MHz();
+    /* SysTick time base first: it bounds the clock waits and the UART waits */
+    Time_Init();
+
+    /* A step that times out leaves the core on the 48 MHz FIRC */
+    if ((0U != SOSC_init_8MHz()) && (0U != SPLL_init_160MHz()))
+    {
+        (void)NormalRUNmode_80MHz();
+    }
 }
 
 /*===============================================================================
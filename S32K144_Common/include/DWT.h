@@ -0,0 +1,50 @@
+/**
+ * @file DWT.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief DWT cycle counter register definition for S32K144 (Cortex-M4)
+ * @version 0.1
+ * @date 2026-03-06
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Shared by the S32K144 projects through S32K144_Common/include.
+ */
+
+#ifndef DWT_H_
+#define DWT_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+/*==================================================================================================
+* DWT REGISTER MAP
+==================================================================================================*/
+
+/**
+ * @brief DWT Register Structure (cycle counter part only)
+ *
+ */
+typedef struct
+{
+    volatile uint32_t CTRL;              /* Control Register */
+    volatile uint32_t CYCCNT;            /* Cycle Count Register (wraps at 2^32) */
+} MY_DWT_Type;
+
+/*==================================================================================================
+* BIT DEFINITIONS
+==================================================================================================*/
+#define MY_DWT_CTRL_CYCCNTENA_MASK   (0x00000001UL)   /* Enable the cycle counter */
+#define MY_DEMCR_TRCENA_MASK         (0x01000000UL)   /* Enable DWT/ITM blocks */
+
+/*==================================================================================================
+* BASE ADDRESS / INSTANCE
+==================================================================================================*/
+#define MY_DWT_BASE    (0xE0001000UL)
+#define MY_DWT         ((MY_DWT_Type *)MY_DWT_BASE)
+
+/* Debug Exception and Monitor Control Register */
+#define MY_DEMCR       (*(volatile uint32_t *)0xE000EDFCUL)
+
+#endif /* DWT_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file TimeBase.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief SysTick time base, delays and timeouts for S32K144
+ * @version 0.1
+ * @date 2026-03-10
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Shared by the S32K144 projects: each links S32K144_Common/src/TimeBase.c
+ * into its src folder and has S32K144_Common/include on its include path.
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* SysTick interrupt rate: Time_Now() unit is 1 / TIME_TICK_HZ s */
+#define TIME_TICK_HZ                  (1000U)
+
+/*==================================================================================================
+* TYPEDEFS
+==================================================================================================*/
+/* Absolute Time_Now() value a timeout expires at */
+typedef uint32_t Time_Deadline_t;
+
+/*==================================================================================================
+* FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief Start (or restart) the SysTick time base from SystemCoreClock.
+ *
+ * Call once at startup and again after every core clock change; the ms
+ * count keeps running across a restart.
+ *
+ */
+void Time_Init(void);
+
+/**
+ * @brief Stop SysTick and drop a pending tick (before jumping to another image).
+ *
+ */
+void Time_Deinit(void);
+
+/**
+ * @brief Milliseconds since Time_Init() (wraps after ~49 days).
+ *
+ * Counted by the SysTick interrupt, so it stands still while interrupts are masked.
+ *
+ * @return uint32_t Time in ms
+ */
+uint32_t Time_Now(void);
+
+/**
+ * @brief Busy-wait for a number of microseconds.
+ *
+ * Counts SysTick core clock ticks, so it is exact to the tick whatever the
+ * optimization level and works with interrupts masked.
+ *
+ * @param us Delay in us (up to 50 s at 80 MHz)
+ */
+void Delay_us(uint32_t us);
+
+/**
+ * @brief Busy-wait for a number of milliseconds.
+ *
+ * @param ms Delay in ms
+ */
+void Delay_ms(uint32_t ms);
+
+/**
+ * @brief Deadline timeout_ms from now.
+ *
+ * The deadline is at least timeout_ms away (the current ms is already partly gone).
+ *
+ * @param timeout_ms Timeout in ms
+ * @return Time_Deadline_t Deadline for Time_Expired()
+ */
+Time_Deadline_t Time_Deadline(uint32_t timeout_ms);
+
+/**
+ * @brief Check a deadline.
+ *
+ * @param deadline Deadline from Time_Deadline()
+ * @return uint8_t 1: deadline reached, 0: time left
+ */
+uint8_t Time_Expired(Time_Deadline_t deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMEBASE_H_ */
@@ -0,0 +1,163 @@
+/**
+ * @file TimeBase.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief SysTick time base, delays and timeouts for S32K144
+ * @version 0.1
+ * @date 2026-03-10
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================================================================================================
+* INCLUDES
+==================================================================================================*/
+#include "TimeBase.h"
+#include "device_registers.h"
+#include "system_S32K144.h"
+
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/**
+ * @brief SysTick Register Structure
+ *
+ */
+typedef struct
+{
+    volatile uint32_t CSR;               /* Control and Status Register */
+    volatile uint32_t RVR;               /* Reload Value Register (24-bit) */
+    volatile uint32_t CVR;               /* Current Value Register (counts down) */
+} MY_SysTick_Type;
+
+#define MY_SYSTICK_BASE               (0xE000E010UL)
+#define MY_SYSTICK                    ((MY_SysTick_Type *)MY_SYSTICK_BASE)
+
+#define MY_SYSTICK_CSR_ENABLE_MASK    (0x00000001UL)
+#define MY_SYSTICK_CSR_TICKINT_MASK   (0x00000002UL)
+#define MY_SYSTICK_CSR_CLKSOURCE_MASK (0x00000004UL)   /* 1: core clock */
+
+#define TIME_US_PER_S                 (1000000UL)
+
+/*==================================================================================================
+* VARIABLES
+==================================================================================================*/
+static volatile uint32_t s_timeMs;
+static uint32_t          s_ticksPerUs;
+
+/*==================================================================================================
+* PROTOTYPES
+==================================================================================================*/
+void SysTick_Handler(void);
+
+/*==================================================================================================
+* INTERRUPT HANDLER
+==================================================================================================*/
+/**
+ * @brief SysTick interrupt: one ms elapsed
+ *
+ */
+void SysTick_Handler(void)
+{
+    s_timeMs++;
+}
+
+/*==================================================================================================
+* PUBLIC FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Start (or restart) the SysTick time base from SystemCoreClock.
+ *
+ */
+void Time_Init(void)
+{
+    s_ticksPerUs = SystemCoreClock / TIME_US_PER_S;
+
+    MY_SYSTICK->CSR = 0U;
+    MY_SYSTICK->RVR = (SystemCoreClock / TIME_TICK_HZ) - 1U;
+    MY_SYSTICK->CVR = 0U;
+    MY_SYSTICK->CSR = MY_SYSTICK_CSR_CLKSOURCE_MASK | MY_SYSTICK_CSR_TICKINT_MASK | MY_SYSTICK_CSR_ENABLE_MASK;
+}
+
+/**
+ * @brief Stop SysTick and drop a pending tick.
+ *
+ */
+void Time_Deinit(void)
+{
+    MY_SYSTICK->CSR = 0U;
+    S32_SCB->ICSR   = S32_SCB_ICSR_PENDSTCLR_MASK;
+}
+
+/**
+ * @brief Milliseconds since Time_Init().
+ *
+ * @return uint32_t Time in ms
+ */
+uint32_t Time_Now(void)
+{
+    return s_timeMs;
+}
+
+/**
+ * @brief Busy-wait for a number of microseconds.
+ *
+ * @param us Delay in us
+ */
+void Delay_us(uint32_t us)
+{
+    uint32_t reload  = MY_SYSTICK->RVR + 1U;
+    uint32_t wait    = us * s_ticksPerUs;
+    uint32_t elapsed = 0U;
+    uint32_t last;
+    uint32_t now;
+
+    if (0U == (MY_SYSTICK->CSR & MY_SYSTICK_CSR_ENABLE_MASK))
+    {
+        return;
+    }
+
+    last = MY_SYSTICK->CVR;
+    while (elapsed < wait)
+    {
+        now      = MY_SYSTICK->CVR;
+        elapsed += (last >= now) ? (last - now) : (last + reload - now);
+        last     = now;
+    }
+}
+
+/**
+ * @brief Busy-wait for a number of milliseconds.
+ *
+ * @param ms Delay in ms
+ */
+void Delay_ms(uint32_t ms)
+{
+    while (0U != ms)
+    {
+        Delay_us(1000U);
+        ms--;
+    }
+}
+
+/**
+ * @brief Deadline timeout_ms from now.
+ *
+ * @param timeout_ms Timeout in ms
+ * @return Time_Deadline_t Deadline for Time_Expired()
+ */
+Time_Deadline_t Time_Deadline(uint32_t timeout_ms)
+{
+    return s_timeMs + timeout_ms + 1U;
+}
+
+/**
+ * @brief Check a deadline.
+ *
+ * @param deadline Deadline from Time_Deadline()
+ * @return uint8_t 1: deadline reached, 0: time left
+ */
+uint8_t Time_Expired(Time_Deadline_t deadline)
+{
+    return ((int32_t)(s_timeMs - deadline) >= 0) ? 1U : 0U;
+}
@@ -14,6 +14,7 @@
 ==================================================================================================*/
 #include "S32K144.h"
 #include "device_registers.h" /* include peripheral declarations S32K144 */
+#include "TimeBase.h"
 
 /*==================================================================================================
 * DEFINES
@@ -24,38 +25,17 @@
 
 #define GPIO_PIN_MASK(pin)           (1UL << (pin))
 
-/* NOTE:
- * This constant is only for a rough busy-wait delay.
- * The real delay depends on core clock and compiler optimization.
- */
-#define DELAY_LOOP_PER_MS            (3000U)
-
-/*==================================================================================================
-* LOCAL FUNCTIONS
-==================================================================================================*/
-/**
- * @brief Busy-wait delay in milliseconds
- *
- * @param ms Delay time in milliseconds
- */
-static void delay_ms(uint32_t ms)
-{
-    uint32_t i = 0U;
+/* Time each LED stays ON / OFF */
+#define BLINK_PERIOD_MS              (3000U)
 
-    /* Busy-wait delay:
-     * Approx loops = ms * DELAY_LOOP_PER_MS.
-     * NOP() helps keep the loop from being optimized away too aggressively.
-     */
-    for (i = 0U; i < (ms * DELAY_LOOP_PER_MS); i++)
-    {
-        NOP();
-    }
-}
 /*==================================================================================================
 * MAIN FUNCTION
 ==================================================================================================*/
 int main(void)
 {
+    /* SysTick time base for Delay_ms (core runs from the 48 MHz FIRC after reset) */
+    Time_Init();
+
     /* Enable clock gating for PORTD in PCC (Peripheral Clock Controller) */
     IP_PCC->PCCn[PCC_PORTD_INDEX] |= PCC_PCCn_CGC_MASK;
 
@@ -76,30 +56,30 @@ int main(void)
          * - output becomes 0 -> LED ON
          */
         IP_PTD->PCOR = GPIO_PIN_MASK(LED_RED_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
 
         /* Turn OFF RED LED:
          * - PSOR sets output bit when writing 1 to that bit position
          * - output becomes 1 -> LED OFF
          */
         IP_PTD->PSOR = GPIO_PIN_MASK(LED_RED_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
 
         /* Turn ON GREEN LED (active-low) */
         IP_PTD->PCOR = GPIO_PIN_MASK(LED_GREEN_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
 
         /* Turn OFF GREEN LED */
         IP_PTD->PSOR = GPIO_PIN_MASK(LED_GREEN_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
 
         /* Turn ON BLUE LED (active-low) */
         IP_PTD->PCOR = GPIO_PIN_MASK(LED_BLUE_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
 
         /* Turn OFF BLUE LED */
         IP_PTD->PSOR = GPIO_PIN_MASK(LED_BLUE_PIN);
-        delay_ms(3000U);
+        Delay_ms(BLINK_PERIOD_MS);
     }
 }
 
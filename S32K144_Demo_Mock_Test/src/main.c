@@ -17,24 +17,25 @@
 
 #include "src/incl/app.h"
 #include "src/incl/Bootloader.h"
+#include "src/incl/BootProgress.h"
+#include "src/incl/BootProto.h"
+#include "src/incl/BootSlot.h"
 #include "src/incl/clocks_and_modes.h"
 #include "src/incl/Driver_GPIO.h"
 #include "src/incl/Driver_USART.h"
 #include "src/incl/NVIC.h"
 #include "src/incl/Queue.h"
 #include "src/incl/srec.h"
+#include "TimeBase.h"
+#include "src/incl/Trace.h"
 #include "src/incl/FLASH.h"
+#include "src/incl/ihex.h"
 
 /*============================================================================
  * DEFINES
  =============================================================================*/
-#define UART_CMD_BUFFER_SIZE   (256U)
 #define BUTTON_1_PIN           (3U)   /* Virtual pin -> PTC12: BTN0      */
 
-/* User application base address */
-#define APP_BASE_ADDR          (0x0000A000UL)
-#define APP_END_ADDR            0x0003FFFFUL   /* inclusive */
-
 /*============================================================================
  * EXTERN DRIVER INSTANCES
  =============================================================================*/
@@ -45,7 +46,8 @@ extern ARM_DRIVER_GPIO         Driver_GPIO0;
  * Variables
  =============================================================================*/
 static Queue_Srec_t             s_srec_queue;
-static srec_record_t            rec;
+static ihex_context_t           s_ihex;
+static uint32_t                 s_entry_point;
 
 /*============================================================================
  * PROTOTYPES
@@ -67,14 +69,22 @@ void WDOG_disable(void)
 }
 
 /**
- * @brief Initialize system clock to 80 MHz
+ * @brief Initialize system clock to 80 MHz, stays on FIRC 48 MHz if SOSC/SPLL fail
  *
  */
 void App_InitClock(void)
 {
-    SOSC_init_8MHz();
-    SPLL_init_160MHz();
-    NormalRUNmode_80MHz();
+    /* Time base for the oscillator/PLL lock timeouts */
+    Time_Init();
+
+    if ((0U != SOSC_init_8MHz()) && (0U != SPLL_init_160MHz()))
+    {
+        (void)NormalRUNmode_80MHz();
+    }
+
+    /* No SysTick interrupt afterwards: its handler is fetched from the P-Flash
+     * block that is busy while an erase/program command runs */
+    Time_Deinit();
 }
 
 /**
@@ -100,33 +110,119 @@ uint8_t Bootloader_IsBootModeByPin()
 }
 
 /**
- * @brief Process one SREC line from queue: pop line, parse and handle it
+ * @brief Handle one payload: bootloader command, SREC or Intel HEX record
  *
- * @param q Pointer to SREC queue
- * @param r Pointer to SREC record structure
- * @param entry_point Pointer to entry point variable
+ * @param line Pointer to NUL-terminated line (records are decoded in place)
+ * @param line_len Line length
+ * @return int32_t BL_OK or bl_status_t error
  */
-static void Boot_ProcessOneQueuedLine(Queue_Srec_t *q, srec_record_t *r, uint32_t *entry_point)
+static int32_t Boot_DeliverLine(uint8_t *line, uint32_t line_len)
 {
-    uint8_t  line[QUEUE_MAX_LINE_LENGTH];
-    uint32_t line_len;
+    int32_t       status = BL_OK;
+    Srec_Status_t srec_st;
+    srec_view_t   rec;
 
-    if (QUEUE_STATUS_OK == Queue_Srec_Pop(q, line, QUEUE_MAX_LINE_LENGTH, &line_len))
+    if ((uint8_t)'#' == line[0])
     {
-        if (line_len < QUEUE_MAX_LINE_LENGTH)
+        Bootloader_HandleCommand(line, line_len);
+    }
+    else
+    {
+        /* Record format is detected per line: ':' Intel HEX, 'S' SREC.
+         * Both decode in place, rec.data points into line. */
+        if (IHEX_START_CODE == line[0])
+        {
+            srec_st = Ihex_ParseLine(&s_ihex, line, line_len, &rec);
+        }
+        else
+        {
+            srec_st = Srec_ParseSrecLineInPlace(line, line_len, &rec);
+        }
+
+        if (SREC_STATUS_OK == srec_st)
         {
-            line[line_len] = '\0';
+            status = Bootloader_HandleRecord(&rec, &s_entry_point);
+        }
+        else if (SREC_STATUS_CHECKSUM == srec_st)
+        {
+            status = BL_ERR_CHECKSUM;
         }
         else
         {
-            line[QUEUE_MAX_LINE_LENGTH - 1U] = '\0';
+            status = BL_ERR_FORMAT;
         }
+    }
+
+    return status;
+}
 
-        if (SREC_STATUS_OK == Srec_ParseSrecLine(line, r))
+/**
+ * @brief Handle one received line: protocol frame or plain line
+ *
+ * Plain lines (no '@' frame) keep working without flow control, but errors
+ * are reported so the host no longer assumes every record landed.
+ *
+ * @param line Pointer to NUL-terminated line
+ * @param line_len Line length
+ */
+static void Boot_HandleLine(uint8_t *line, uint32_t line_len)
+{
+    int32_t status;
+
+    if (BOOTPROTO_FRAME_START == line[0])
+    {
+        BootProto_HandleFrame(line, line_len);
+    }
+    else
+    {
+        status = Boot_DeliverLine(line, line_len);
+
+        if ((BL_ERR_FORMAT == status) || (BL_ERR_CHECKSUM == status))
         {
-            Bootloader_HandleRecord(r, entry_point);
+            App_SendString("NAK\r\n");
         }
+        else if (BL_OK != status)
+        {
+            App_SendString("ERR\r\n");
+        }
+        else
+        {
+            /* Record handled */
+        }
+    }
+}
+
+/**
+ * @brief Process one SREC line from queue: pop line, parse and handle it
+ *
+ * @param q Pointer to SREC queue
+ * @return uint8_t 1: a line was popped, 0: queue empty
+ */
+static uint8_t Boot_ProcessOneQueuedLine(Queue_Srec_t *q)
+{
+    uint8_t        line[QUEUE_MAX_LINE_LENGTH + 1U];   /* + NUL */
+    uint32_t       line_len;
+    uint8_t        popped = 1U;
+    Queue_Status_t qst;
+
+    qst = Queue_Srec_Pop(q, line, QUEUE_MAX_LINE_LENGTH, &line_len);
+
+    if (QUEUE_STATUS_OK == qst)
+    {
+        line[line_len] = '\0';
+        Boot_HandleLine(line, line_len);
+    }
+    else if (QUEUE_STATUS_TRUNCATED == qst)
+    {
+        /* Never parse a cut line */
+        App_SendString("NAK\r\n");
+    }
+    else
+    {
+        popped = 0U;
     }
+
+    return popped;
 }
 
 
@@ -137,15 +233,10 @@ int main(void)
 {
 	ARM_DRIVER_USART *usart;
 	int32_t           status;
-	uint8_t           rx_char;
 	uint8_t           c;
-	uint8_t           cmd_buffer[UART_CMD_BUFFER_SIZE];
-	uint32_t          cmd_index;
-	uint8_t           line[QUEUE_MAX_LINE_LENGTH];
-	uint32_t          line_len;
-	uint32_t          entry_point;
-
-	line_len   = 0U;
+	Queue_Line_t      cmd_line;
+	Queue_LineEvent_t event;
+	uint8_t           active_slot;
 
 	usart = &Driver_USART0;
 
@@ -153,6 +244,7 @@ int main(void)
 	App_InitClock();
 
 	Boot_PinInit();
+	Trace_Init();
 
 	/* Initialize USART */
 	status = usart->Initialize(USART1_SignalEvent);
@@ -193,12 +285,17 @@ int main(void)
 		}
 	}
 
+	/* Pick the newest valid slot from the status records */
+	BootSlot_Init();
+	active_slot = BootSlot_GetActive();
+
 	/* Check if need to enter bootloader mode */
 	if (1U == Bootloader_IsBootModeByPin())
 	{
-		if (0U != Bootloader_IsUserAppValid(APP_BASE_ADDR))
+		if ((BOOTSLOT_NONE != active_slot) &&
+		    (0U != Bootloader_IsUserAppValid(BootSlot_GetBaseAddr(active_slot))))
 		{
-			Bootloader_JumpToUserApp(APP_BASE_ADDR);
+			Bootloader_JumpToUserApp(BootSlot_GetBaseAddr(active_slot));
 		}
 		else
 		{
@@ -207,21 +304,42 @@ int main(void)
 	}
 
 	Queue_Srec_Init(&s_srec_queue);
+	Ihex_Init(&s_ihex);
 
-	cmd_index   = 0U;
-	entry_point = 0UL;
+	BootProto_Init(Boot_DeliverLine);
 
-	cmd_buffer[0] = '\0';
+	Queue_Line_Init(&cmd_line);
+	s_entry_point = 0UL;
 
 	App_SendString("\r\n*** ERASE PROCESSING ***\r\n");
 
+	/* Only the inactive slot is written, the running image stays intact */
 	Mem_43_INFLS_IPW_LoadAc();
-	(void)Erase_Multi_Sector(APP_BASE_ADDR, (APP_END_ADDR - APP_BASE_ADDR)/FTFC_P_FLASH_SECTOR_SIZE);
+	if (BL_OK != BootSlot_BeginDownload())
+	{
+		App_SendString("\r\n*** ERASE FAILED ***\r\n");
+	}
+
+	/* Keep sectors verified by an interrupted download of the same slot */
+	if (0U != BootProgress_Open(BootSlot_GetTarget(), BootSlot_GetActiveSequence()))
+	{
+		App_SendString("\r\n*** RESUMING DOWNLOAD, SEND MISSING RANGES ONLY ***\r\n");
+		BootProgress_Report();
+	}
+
+	if (BOOTSLOT_B == BootSlot_GetTarget())
+	{
+		App_SendString("\r\n*** TARGET SLOT B (0x00045000) ***\r\n");
+	}
+	else
+	{
+		App_SendString("\r\n*** TARGET SLOT A (0x0000A000) ***\r\n");
+	}
 
 	App_SendString("\r\n*** UART BOOTLOADER READY TO SENT ***\r\n");
 	App_SendString("\r\n*** PLEASE SEND SREC FILE ***\r\n");
 
-	status = usart->Receive(&rx_char, 1U);
+	status = App_StartReceive();
 	if (status != ARM_DRIVER_OK)
 	{
 		while (1)
@@ -232,61 +350,24 @@ int main(void)
 
 	while (1)
 	{
-	    uint32_t ev = usart_events;
-
-	    if ((ev & ARM_USART_EVENT_RECEIVE_COMPLETE) != 0U)
+	    if (0U != App_ReadByte(&c))
 	    {
-	        /* clear event */
-	        usart_events &= ~ARM_USART_EVENT_RECEIVE_COMPLETE;
+	        event = Queue_Line_PutChar(&cmd_line, &s_srec_queue, c, Boot_ProcessOneQueuedLine);
 
-	        c = rx_char;
-
-	        (void)usart->Receive(&rx_char, 1U);
-
-	        if ((c == (uint8_t)'\r') || (c == (uint8_t)'\n'))
+	        if (QUEUE_LINE_DROPPED == event)
 	        {
-	            if (cmd_index > 0U)
-	            {
-	                Queue_Status_t qst;
-
-	                qst = Queue_Srec_Push(&s_srec_queue, cmd_buffer, cmd_index);
-
-	                while (qst == QUEUE_STATUS_FULL)
-	                {
-	                    Boot_ProcessOneQueuedLine(&s_srec_queue, &rec, &entry_point);
-	                    qst = Queue_Srec_Push(&s_srec_queue, cmd_buffer, cmd_index);
-	                }
-
-	                cmd_index = 0U;
-
-	                while (Queue_Srec_Pop(&s_srec_queue, line, QUEUE_MAX_LINE_LENGTH, &line_len) == QUEUE_STATUS_OK)
-	                {
-	                    if (line_len < QUEUE_MAX_LINE_LENGTH) { line[line_len] = '\0'; }
-	                    else { line[QUEUE_MAX_LINE_LENGTH - 1U] = '\0'; }
-
-	                    if (SREC_STATUS_OK == Srec_ParseSrecLine(line, &rec))
-	                    {
-	                        Bootloader_HandleRecord(&rec, &entry_point);
-	                    }
-	                }
-	            }
-	            else
+	            App_SendString("NAK\r\n");
+	        }
+	        else if (QUEUE_LINE_PUSHED == event)
+	        {
+	            while (0U != Boot_ProcessOneQueuedLine(&s_srec_queue))
 	            {
-	                /* empty line -> ignore */
+	                /* Drain queue */
 	            }
 	        }
 	        else
 	        {
-	            /* normal char */
-	            if (cmd_index < (UART_CMD_BUFFER_SIZE - 1U))
-	            {
-	                cmd_buffer[cmd_index++] = c;
-	            }
-	            else
-	            {
-	                /* overflow: reset */
-	                cmd_index = 0U;
-	            }
+	            /* line not complete yet */
 	        }
 	    }
 	}
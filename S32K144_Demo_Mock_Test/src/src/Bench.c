@@ -0,0 +1,213 @@
+/**
+ * @file Bench.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Micro-benchmark harness: DWT cycle counter on target, clock_gettime on host
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/Bench.h"
+
+#include <stddef.h>
+
+#if defined(BENCH_HOST)
+#include <time.h>
+#else
+#include "DWT.h"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_DEC_DIGITS           (10U)   /* UINT32_MAX */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void     Bench_SortU32(uint32_t *v, uint32_t n);
+static void     Bench_PrintU32(Bench_Print_t print, uint32_t value);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#if !defined(BENCH_HOST)
+static uint32_t s_cycles_last = 0U;
+static uint32_t s_cycles_high = 0U;
+#endif
+static uint32_t s_samples[BENCH_MAX_REPS];
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Sort samples ascending (insertion sort, n is small)
+ *
+ * @param v Samples
+ * @param n Number of samples
+ */
+static void Bench_SortU32(uint32_t *v, uint32_t n)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t key;
+
+    for (i = 1U; i < n; i++)
+    {
+        key = v[i];
+        j   = i;
+
+        while ((j > 0U) && (v[j - 1U] > key))
+        {
+            v[j] = v[j - 1U];
+            j--;
+        }
+
+        v[j] = key;
+    }
+}
+
+/**
+ * @brief Print an unsigned value in decimal
+ *
+ * @param print Output function
+ * @param value Value
+ */
+static void Bench_PrintU32(Bench_Print_t print, uint32_t value)
+{
+    char     buf[BENCH_DEC_DIGITS + 1U];
+    uint32_t pos = BENCH_DEC_DIGITS;
+
+    buf[pos] = '\0';
+
+    do
+    {
+        pos--;
+        buf[pos] = (char)('0' + (value % 10U));
+        value   /= 10U;
+    } while (0U != value);
+
+    print(&buf[pos]);
+}
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/**
+ * @brief Free running 64-bit time stamp
+ *
+ * Target: core cycles. CYCCNT is enabled on first use and extended to 64 bits;
+ * it wraps every ~53 s at 80 MHz, so this must be called at least that often
+ * for long intervals. Host: nanoseconds of CLOCK_MONOTONIC.
+ *
+ * @return uint64_t Time stamp in BENCH_UNIT
+ */
+uint64_t Bench_GetCycles(void)
+{
+#if defined(BENCH_HOST)
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#else
+    uint32_t now;
+
+    if (0UL == (MY_DWT->CTRL & MY_DWT_CTRL_CYCCNTENA_MASK))
+    {
+        MY_DEMCR      |= MY_DEMCR_TRCENA_MASK;
+        MY_DWT->CYCCNT = 0UL;
+        MY_DWT->CTRL  |= MY_DWT_CTRL_CYCCNTENA_MASK;
+    }
+
+    now = MY_DWT->CYCCNT;
+    if (now < s_cycles_last)
+    {
+        s_cycles_high++;
+    }
+    s_cycles_last = now;
+
+    return ((uint64_t)s_cycles_high << 32) | (uint64_t)now;
+#endif
+}
+
+/**
+ * @brief Run benchmarks and print min/median/max per case
+ *
+ * Every case runs warmup untimed repetitions (caches, flash prefetch), then
+ * reps timed ones. The timer overhead, measured the same way, is subtracted.
+ *
+ * @param cases Benchmark table
+ * @param count Number of cases
+ * @param warmup Untimed repetitions
+ * @param reps Timed repetitions (at most BENCH_MAX_REPS)
+ * @param print Output function
+ */
+void Bench_Run(const Bench_Case_t *cases, uint32_t count, uint32_t warmup, uint32_t reps,
+               Bench_Print_t print)
+{
+    uint64_t t0;
+    uint64_t t1;
+    uint32_t overhead = 0xFFFFFFFFUL;
+    uint32_t c;
+    uint32_t i;
+    uint32_t dt;
+
+    if ((NULL == cases) || (NULL == print) || (0U == reps))
+    {
+        return;
+    }
+
+    if (reps > BENCH_MAX_REPS)
+    {
+        reps = BENCH_MAX_REPS;
+    }
+
+    /* Cost of an empty measurement */
+    for (i = 0U; i < reps; i++)
+    {
+        t0 = Bench_GetCycles();
+        t1 = Bench_GetCycles();
+        dt = (uint32_t)(t1 - t0);
+        if (dt < overhead)
+        {
+            overhead = dt;
+        }
+    }
+
+    for (c = 0U; c < count; c++)
+    {
+        for (i = 0U; i < (warmup + reps); i++)
+        {
+            if (NULL != cases[c].setup)
+            {
+                cases[c].setup(cases[c].ctx);
+            }
+
+            t0 = Bench_GetCycles();
+            cases[c].run(cases[c].ctx);
+            t1 = Bench_GetCycles();
+
+            if (i >= warmup)
+            {
+                dt = (uint32_t)(t1 - t0);
+                s_samples[i - warmup] = (dt > overhead) ? (dt - overhead) : 0U;
+            }
+        }
+
+        Bench_SortU32(s_samples, reps);
+
+        print("BENCH,");
+        print(cases[c].name);
+        print("," BENCH_UNIT ",");
+        Bench_PrintU32(print, reps);
+        print(",");
+        Bench_PrintU32(print, s_samples[0]);
+        print(",");
+        Bench_PrintU32(print, s_samples[reps / 2U]);
+        print(",");
+        Bench_PrintU32(print, s_samples[reps - 1U]);
+        print("\r\n");
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @file BootBench.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Micro-benchmarks of the bootloader hot paths
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Hardware-independent: the same cases run on target ("#BENCH") and on the
+ * host ("bltool microbench", built with BENCH_HOST).
+ */
+#include "incl/BootBench.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/Crc32.h"
+#include "incl/ihex.h"
+#include "incl/Queue.h"
+#include "incl/srec.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* 32 data bytes at 0x0000A000, the typical linker record */
+#define BOOTBENCH_SREC_LINE   "S3250000A000202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F4A"
+#define BOOTBENCH_IHEX_LINE   ":20A00000202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F50"
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Line buffer shared by the cases (decoded in place by some)
+ */
+typedef struct
+{
+    const char *text;
+    uint32_t    len;
+    uint8_t     line[QUEUE_MAX_LINE_LENGTH + 1U];
+} BootBench_Line_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void BootBench_LineSetup(void *ctx);
+static void BootBench_SrecCopy(void *ctx);
+static void BootBench_SrecInPlace(void *ctx);
+static void BootBench_Ihex(void *ctx);
+static void BootBench_Crc32(void *ctx);
+static void BootBench_QueuePushPop(void *ctx);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static BootBench_Line_t s_srec = { BOOTBENCH_SREC_LINE, sizeof(BOOTBENCH_SREC_LINE) - 1U, { 0U } };
+static BootBench_Line_t s_ihex = { BOOTBENCH_IHEX_LINE, sizeof(BOOTBENCH_IHEX_LINE) - 1U, { 0U } };
+static Queue_Srec_t     s_queue;
+static volatile uint32_t s_sink;    /* keeps results alive */
+
+static const Bench_Case_t s_cases[] =
+{
+    { "srec_parse_copy",    BootBench_LineSetup, BootBench_SrecCopy,     &s_srec },
+    { "srec_parse_inplace", BootBench_LineSetup, BootBench_SrecInPlace,  &s_srec },
+    { "ihex_parse",         BootBench_LineSetup, BootBench_Ihex,         &s_ihex },
+    { "crc32_line",         BootBench_LineSetup, BootBench_Crc32,        &s_srec },
+    { "queue_push_pop",     BootBench_LineSetup, BootBench_QueuePushPop, &s_srec },
+};
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Restore the ASCII line (in-place parsers overwrite it)
+ */
+static void BootBench_LineSetup(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+
+    (void)memcpy(l->line, l->text, l->len + 1U);
+}
+
+/**
+ * @brief Srec_ParseSrecLine: decode into a full srec_record_t
+ */
+static void BootBench_SrecCopy(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+    srec_record_t     rec;
+
+    (void)Srec_ParseSrecLine(l->line, &rec);
+    s_sink = rec.data_len;
+}
+
+/**
+ * @brief Srec_ParseSrecLineInPlace: decode into the line buffer
+ */
+static void BootBench_SrecInPlace(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+    srec_view_t       view;
+
+    (void)Srec_ParseSrecLineInPlace(l->line, l->len, &view);
+    s_sink = view.data_len;
+}
+
+/**
+ * @brief Ihex_ParseLine: decode an Intel HEX data record in place
+ */
+static void BootBench_Ihex(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+    ihex_context_t    ihex;
+    srec_view_t       view;
+
+    Ihex_Init(&ihex);
+    (void)Ihex_ParseLine(&ihex, l->line, l->len, &view);
+    s_sink = view.data_len;
+}
+
+/**
+ * @brief Crc32_Compute over one ASCII line
+ */
+static void BootBench_Crc32(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+
+    s_sink = Crc32_Compute(l->line, l->len);
+}
+
+/**
+ * @brief Queue_Srec_Push followed by Queue_Srec_Pop of one line
+ */
+static void BootBench_QueuePushPop(void *ctx)
+{
+    BootBench_Line_t *l = (BootBench_Line_t *)ctx;
+    uint8_t           out[QUEUE_MAX_LINE_LENGTH];
+    uint32_t          out_len;
+
+    (void)Queue_Srec_Push(&s_queue, l->line, l->len);
+    (void)Queue_Srec_Pop(&s_queue, out, QUEUE_MAX_LINE_LENGTH, &out_len);
+    s_sink = out_len;
+}
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/**
+ * @brief Run all bootloader micro-benchmarks
+ *
+ * @param print Output function (App_SendString on target)
+ */
+void BootBench_RunAll(Bench_Print_t print)
+{
+    (void)Queue_Srec_Init(&s_queue);
+
+    Bench_Run(s_cases, (uint32_t)(sizeof(s_cases) / sizeof(s_cases[0])),
+              BOOTBENCH_WARMUP, BOOTBENCH_REPS, print);
+
+    print("BENCH,END\r\n");
+}
@@ -0,0 +1,416 @@
+/**
+ * @file BootDelta.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Differential (delta) image update for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-23
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/BootDelta.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/app.h"
+#include "incl/Bootloader.h"
+#include "incl/BootSlot.h"
+#include "incl/FLASH.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTDELTA_SECTOR_SIZE      (BOOTSLOT_SECTOR_SIZE)
+#define BOOTDELTA_PHRASE_SIZE      (FTFC_WRITE_DOUBLE_WORD)
+#define BOOTDELTA_MAX_ARGS         (6U)
+#define BOOTDELTA_MAX_RUNS         (16U)  /* runs of non-blank phrases per batch */
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Streaming op decoder state
+ */
+typedef struct
+{
+    uint32_t old_base;
+    uint32_t new_base;
+    uint32_t stream_off;              /* next expected stream offset */
+    uint32_t out_pos;                 /* bytes of new image produced */
+    uint32_t remaining;               /* literal bytes still to take */
+    uint32_t sectors_written;
+    uint32_t sectors_skipped;
+    uint8_t  op;
+    uint8_t  args[BOOTDELTA_MAX_ARGS];
+    uint8_t  arg_need;
+    uint8_t  arg_have;
+    uint8_t  active;
+} BootDelta_State_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint8_t BootDelta_ReadOldByte(uint32_t offset);
+static uint8_t BootDelta_IsBlankPhrase(uint32_t off);
+static int32_t BootDelta_FlushSector(void);
+static int32_t BootDelta_EmitByte(uint8_t value);
+static int32_t BootDelta_EmitOld(uint32_t old_offset, uint32_t len);
+static int32_t BootDelta_StartOp(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static BootDelta_State_t s_delta;
+static uint32_t          s_staging[BOOTDELTA_SECTOR_SIZE / 4U];   /* word aligned */
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Read one byte of the old (active) image
+ *
+ * @param offset Offset from the old slot base
+ * @return uint8_t Byte value
+ */
+static uint8_t BootDelta_ReadOldByte(uint32_t offset)
+{
+    uint32_t addr = s_delta.old_base + offset;
+    uint32_t word = Read_FlashAddress(addr & ~3UL);
+
+    return (uint8_t)(word >> ((addr & 3UL) * 8U));
+}
+
+/**
+ * @brief Check whether a staged phrase is all 0xFF (nothing to program)
+ *
+ * @param off Offset of the phrase in the staged sector
+ * @return uint8_t 1: blank, 0: holds data
+ */
+static uint8_t BootDelta_IsBlankPhrase(uint32_t off)
+{
+    return ((0xFFFFFFFFUL == s_staging[off / 4U]) && (0xFFFFFFFFUL == s_staging[(off / 4U) + 1U])) ? 1U : 0U;
+}
+
+/**
+ * @brief Write the staged sector to the target slot if its content changed
+ *
+ * The staged sector is the one that contains out_pos - 1. Bytes not produced
+ * yet are 0xFF (erased). Runs of non-blank phrases are programmed by the RAM
+ * batch kernel, then the whole sector is read back.
+ *
+ * @return int32_t BL_OK, BL_ERR_FLASH, BL_ERR_VERIFY
+ */
+static int32_t BootDelta_FlushSector(void)
+{
+    int32_t             status  = BL_OK;
+    uint32_t            sector  = (s_delta.out_pos - 1U) / BOOTDELTA_SECTOR_SIZE;
+    uint32_t            addr    = s_delta.new_base + (sector * BOOTDELTA_SECTOR_SIZE);
+    uint8_t             changed = 0U;
+    uint32_t            runs    = 0U;
+    uint32_t            off;
+    Flash_ProgramDesc_t desc[BOOTDELTA_MAX_RUNS];
+
+    for (off = 0U; off < BOOTDELTA_SECTOR_SIZE; off += 4U)
+    {
+        if (Read_FlashAddress(addr + off) != s_staging[off / 4U])
+        {
+            changed = 1U;
+            break;
+        }
+    }
+
+    if (0U == changed)
+    {
+        s_delta.sectors_skipped++;
+    }
+    else
+    {
+        if (0U == Erase_Sector(addr))
+        {
+            status = BL_ERR_FLASH;
+        }
+
+        for (off = 0U; (off < BOOTDELTA_SECTOR_SIZE) && (BL_OK == status); off += BOOTDELTA_PHRASE_SIZE)
+        {
+            if (0U != BootDelta_IsBlankPhrase(off))
+            {
+                /* Erased already */
+            }
+            else if ((0U != runs) &&
+                     ((desc[runs - 1U].Addr + (desc[runs - 1U].Phrases * BOOTDELTA_PHRASE_SIZE)) == (addr + off)))
+            {
+                desc[runs - 1U].Phrases++;
+            }
+            else
+            {
+                if (BOOTDELTA_MAX_RUNS == runs)
+                {
+                    status = (0U != Flash_ProgramBatch(desc, runs)) ? BL_OK : BL_ERR_FLASH;
+                    runs   = 0U;
+                }
+
+                desc[runs].Addr    = addr + off;
+                desc[runs].Src     = (const uint8_t *)&s_staging[off / 4U];
+                desc[runs].Phrases = 1U;
+                runs++;
+            }
+        }
+
+        if ((BL_OK == status) && (0U != runs) && (0U == Flash_ProgramBatch(desc, runs)))
+        {
+            status = BL_ERR_FLASH;
+        }
+
+        for (off = 0U; (off < BOOTDELTA_SECTOR_SIZE) && (BL_OK == status); off += 4U)
+        {
+            if (Read_FlashAddress(addr + off) != s_staging[off / 4U])
+            {
+                status = BL_ERR_VERIFY;
+            }
+        }
+
+        s_delta.sectors_written++;
+    }
+
+    (void)memset(s_staging, 0xFF, sizeof(s_staging));
+
+    return status;
+}
+
+/**
+ * @brief Append one byte to the new image
+ *
+ * @param value Byte value
+ * @return int32_t BL_OK, BL_ERR_RANGE or flush error
+ */
+static int32_t BootDelta_EmitByte(uint8_t value)
+{
+    int32_t status = BL_OK;
+
+    if (s_delta.out_pos >= BOOTSLOT_SIZE)
+    {
+        status = BL_ERR_RANGE;
+    }
+    else
+    {
+        ((uint8_t *)s_staging)[s_delta.out_pos % BOOTDELTA_SECTOR_SIZE] = value;
+        s_delta.out_pos++;
+
+        if (0U == (s_delta.out_pos % BOOTDELTA_SECTOR_SIZE))
+        {
+            status = BootDelta_FlushSector();
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Append a run of the old image to the new image
+ *
+ * @param old_offset Offset in the old slot
+ * @param len Number of bytes
+ * @return int32_t BL_OK, BL_ERR_RANGE or flush error
+ */
+static int32_t BootDelta_EmitOld(uint32_t old_offset, uint32_t len)
+{
+    int32_t  status = BL_OK;
+    uint32_t i;
+
+    if ((old_offset > BOOTSLOT_SIZE) || (len > (BOOTSLOT_SIZE - old_offset)))
+    {
+        status = BL_ERR_RANGE;
+    }
+
+    for (i = 0U; (i < len) && (BL_OK == status); i++)
+    {
+        status = BootDelta_EmitByte(BootDelta_ReadOldByte(old_offset + i));
+    }
+
+    return status;
+}
+
+/**
+ * @brief Execute the op whose arguments are complete
+ *
+ * @return int32_t BL_OK or error
+ */
+static int32_t BootDelta_StartOp(void)
+{
+    int32_t  status = BL_OK;
+    uint32_t off;
+    uint32_t len;
+
+    switch (s_delta.op)
+    {
+        case BOOTDELTA_OP_COPY:
+        {
+            off = (uint32_t)s_delta.args[0]         | ((uint32_t)s_delta.args[1] << 8U) |
+                  ((uint32_t)s_delta.args[2] << 16U) | ((uint32_t)s_delta.args[3] << 24U);
+            len = (uint32_t)s_delta.args[4] | ((uint32_t)s_delta.args[5] << 8U);
+            status = BootDelta_EmitOld(off, len);
+            break;
+        }
+
+        case BOOTDELTA_OP_SKIP:
+        {
+            len = (uint32_t)s_delta.args[0] | ((uint32_t)s_delta.args[1] << 8U);
+            status = BootDelta_EmitOld(s_delta.out_pos, len);
+            break;
+        }
+
+        case BOOTDELTA_OP_LITERAL:
+        {
+            s_delta.remaining = (uint32_t)s_delta.args[0] | ((uint32_t)s_delta.args[1] << 8U);
+            break;
+        }
+
+        default:
+        {
+            status = BL_ERR_FORMAT;
+            break;
+        }
+    }
+
+    s_delta.arg_need = 0U;
+    s_delta.arg_have = 0U;
+
+    return status;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Start a delta update
+ *
+ * @param old_base Base address of the old (active) image
+ * @param new_base Base address of the target slot
+ * @return int32_t BL_OK
+ */
+int32_t BootDelta_Begin(uint32_t old_base, uint32_t new_base)
+{
+    (void)memset(&s_delta, 0, sizeof(s_delta));
+    (void)memset(s_staging, 0xFF, sizeof(s_staging));
+
+    s_delta.old_base = old_base;
+    s_delta.new_base = new_base;
+    s_delta.active   = 1U;
+
+    return BL_OK;
+}
+
+/**
+ * @brief Feed delta stream bytes
+ *
+ * @param stream_offset Offset of data in the delta stream
+ * @param data Stream bytes
+ * @param len Number of bytes
+ * @return int32_t BL_OK or error
+ */
+int32_t BootDelta_Write(uint32_t stream_offset, const uint8_t *data, uint32_t len)
+{
+    int32_t  status = BL_OK;
+    uint32_t i      = 0U;
+    uint8_t  b;
+
+    if ((NULL == data) || (0U == s_delta.active))
+    {
+        status = BL_ERR_PARAM;
+    }
+    else if (stream_offset != s_delta.stream_off)
+    {
+        /* Lost or repeated record */
+        status = BL_ERR_FORMAT;
+    }
+    else
+    {
+        s_delta.stream_off += len;
+    }
+
+    while ((BL_OK == status) && (i < len))
+    {
+        b = data[i];
+        i++;
+
+        if (0U != s_delta.remaining)
+        {
+            status = BootDelta_EmitByte(b);
+            s_delta.remaining--;
+        }
+        else if (0U != s_delta.arg_need)
+        {
+            s_delta.args[s_delta.arg_have] = b;
+            s_delta.arg_have++;
+
+            if (s_delta.arg_have == s_delta.arg_need)
+            {
+                status = BootDelta_StartOp();
+            }
+        }
+        else
+        {
+            s_delta.op = b;
+
+            if (BOOTDELTA_OP_COPY == b)
+            {
+                s_delta.arg_need = 6U;
+            }
+            else if ((BOOTDELTA_OP_LITERAL == b) || (BOOTDELTA_OP_SKIP == b))
+            {
+                s_delta.arg_need = 2U;
+            }
+            else
+            {
+                status = BL_ERR_FORMAT;
+            }
+        }
+    }
+
+    if (BL_OK != status)
+    {
+        s_delta.active = 0U;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Finish the delta update: write the last partial sector
+ *
+ * @param image_size Output: size of the rebuilt image
+ * @return int32_t BL_OK or error
+ */
+int32_t BootDelta_End(uint32_t *image_size)
+{
+    int32_t status = BL_OK;
+
+    if ((NULL == image_size) || (0U == s_delta.active))
+    {
+        status = BL_ERR_PARAM;
+    }
+    else if ((0U != s_delta.remaining) || (0U != s_delta.arg_need) || (0U == s_delta.out_pos))
+    {
+        /* Truncated stream */
+        status = BL_ERR_FORMAT;
+    }
+    else
+    {
+        if (0U != (s_delta.out_pos % BOOTDELTA_SECTOR_SIZE))
+        {
+            status = BootDelta_FlushSector();
+        }
+
+        *image_size = s_delta.out_pos;
+
+        App_SendString("DELTA SECTORS WRITTEN ");
+        App_SendHex32(s_delta.sectors_written);
+        App_SendString(" SKIPPED ");
+        App_SendHex32(s_delta.sectors_skipped);
+        App_SendString("\r\n");
+    }
+
+    s_delta.active = 0U;
+
+    return status;
+}
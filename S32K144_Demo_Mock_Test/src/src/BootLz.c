@@ -0,0 +1,277 @@
+/**
+ * @file BootLz.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Streaming LZSS decompression for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/BootLz.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/Bootloader.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTLZ_WINDOW_MASK          (BOOTLZ_WINDOW_SIZE - 1U)
+#define BOOTLZ_FLUSH_SIZE           (256U)   /* divides the window: chunks never wrap */
+#define BOOTLZ_DIST_MASK            ((1U << BOOTLZ_DIST_BITS) - 1U)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Decoder state
+ */
+typedef enum
+{
+    BOOTLZ_STATE_FLAGS = 0,
+    BOOTLZ_STATE_ITEM,
+    BOOTLZ_STATE_TOKEN_HI
+} BootLz_Step_t;
+
+typedef struct
+{
+    BootLz_Output_t output;
+    uint32_t        base;
+    uint32_t        stream_off;     /* next expected stream offset */
+    uint32_t        out_pos;        /* bytes produced */
+    uint32_t        flushed;        /* bytes handed to the output */
+    uint8_t         flags;
+    uint8_t         items;          /* items left in the current group */
+    uint8_t         token_lo;
+    uint8_t         step;
+    uint8_t         active;
+} BootLz_State_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static int32_t BootLz_Flush(void);
+static int32_t BootLz_PutByte(uint8_t value);
+static int32_t BootLz_Match(uint16_t token);
+static void    BootLz_NextItem(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static BootLz_State_t s_lz;
+static uint8_t        s_window[BOOTLZ_WINDOW_SIZE];
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Hand the bytes produced since the last flush to the output
+ *
+ * @return int32_t BL_OK or error of the output
+ */
+static int32_t BootLz_Flush(void)
+{
+    int32_t  status = BL_OK;
+    uint32_t len    = s_lz.out_pos - s_lz.flushed;
+
+    if (0U != len)
+    {
+        status = s_lz.output(s_lz.base + s_lz.flushed,
+                             &s_window[s_lz.flushed & BOOTLZ_WINDOW_MASK], len);
+        s_lz.flushed = s_lz.out_pos;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Append one decompressed byte
+ *
+ * @param value Byte value
+ * @return int32_t BL_OK or error
+ */
+static int32_t BootLz_PutByte(uint8_t value)
+{
+    int32_t status = BL_OK;
+
+    s_window[s_lz.out_pos & BOOTLZ_WINDOW_MASK] = value;
+    s_lz.out_pos++;
+
+    if (0U == (s_lz.out_pos % BOOTLZ_FLUSH_SIZE))
+    {
+        status = BootLz_Flush();
+    }
+
+    return status;
+}
+
+/**
+ * @brief Expand a match token from the window
+ *
+ * @param token Match token
+ * @return int32_t BL_OK or error
+ */
+static int32_t BootLz_Match(uint16_t token)
+{
+    int32_t  status = BL_OK;
+    uint32_t dist   = ((uint32_t)token & BOOTLZ_DIST_MASK) + 1U;
+    uint32_t len    = ((uint32_t)token >> BOOTLZ_DIST_BITS) + BOOTLZ_MIN_MATCH;
+
+    if (dist > s_lz.out_pos)
+    {
+        /* Reference before the start of the image */
+        status = BL_ERR_FORMAT;
+    }
+
+    while ((BL_OK == status) && (0U != len))
+    {
+        status = BootLz_PutByte(s_window[(s_lz.out_pos - dist) & BOOTLZ_WINDOW_MASK]);
+        len--;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Advance to the next item of the current group
+ */
+static void BootLz_NextItem(void)
+{
+    s_lz.flags >>= 1;
+    s_lz.items--;
+
+    if (0U == s_lz.items)
+    {
+        s_lz.step = (uint8_t)BOOTLZ_STATE_FLAGS;
+    }
+    else
+    {
+        s_lz.step = (uint8_t)BOOTLZ_STATE_ITEM;
+    }
+}
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/**
+ * @brief Start a compressed download
+ *
+ * @param base Address of the first decompressed byte
+ * @param output Sink for decompressed data
+ * @return int32_t BL_OK or BL_ERR_PARAM
+ */
+int32_t BootLz_Begin(uint32_t base, BootLz_Output_t output)
+{
+    int32_t status = BL_OK;
+
+    (void)memset(&s_lz, 0, sizeof(s_lz));
+
+    if (NULL == output)
+    {
+        status = BL_ERR_PARAM;
+    }
+    else
+    {
+        s_lz.output = output;
+        s_lz.base   = base;
+        s_lz.step   = (uint8_t)BOOTLZ_STATE_FLAGS;
+        s_lz.active = 1U;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Feed compressed stream bytes
+ *
+ * @param stream_offset Offset of data in the compressed stream
+ * @param data Stream bytes
+ * @param len Number of bytes
+ * @return int32_t BL_OK or error
+ */
+int32_t BootLz_Write(uint32_t stream_offset, const uint8_t *data, uint32_t len)
+{
+    int32_t  status = BL_OK;
+    uint32_t i      = 0U;
+    uint8_t  b;
+
+    if ((NULL == data) || (0U == s_lz.active))
+    {
+        status = BL_ERR_PARAM;
+    }
+    else if (stream_offset != s_lz.stream_off)
+    {
+        /* Lost or repeated record */
+        status = BL_ERR_FORMAT;
+    }
+    else
+    {
+        s_lz.stream_off += len;
+    }
+
+    while ((BL_OK == status) && (i < len))
+    {
+        b = data[i];
+        i++;
+
+        if ((uint8_t)BOOTLZ_STATE_FLAGS == s_lz.step)
+        {
+            s_lz.flags = b;
+            s_lz.items = 8U;
+            s_lz.step  = (uint8_t)BOOTLZ_STATE_ITEM;
+        }
+        else if ((uint8_t)BOOTLZ_STATE_TOKEN_HI == s_lz.step)
+        {
+            status = BootLz_Match((uint16_t)(((uint16_t)b << 8) | s_lz.token_lo));
+            BootLz_NextItem();
+        }
+        else if (0U != (s_lz.flags & 0x01U))
+        {
+            status = BootLz_PutByte(b);
+            BootLz_NextItem();
+        }
+        else
+        {
+            s_lz.token_lo = b;
+            s_lz.step     = (uint8_t)BOOTLZ_STATE_TOKEN_HI;
+        }
+    }
+
+    if (BL_OK != status)
+    {
+        s_lz.active = 0U;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Finish the compressed download: hand out the last bytes
+ *
+ * @param image_size Output: number of decompressed bytes
+ * @return int32_t BL_OK or error
+ */
+int32_t BootLz_End(uint32_t *image_size)
+{
+    int32_t status = BL_OK;
+
+    if ((NULL == image_size) || (0U == s_lz.active))
+    {
+        status = BL_ERR_PARAM;
+    }
+    else if (((uint8_t)BOOTLZ_STATE_TOKEN_HI == s_lz.step) || (0U == s_lz.out_pos))
+    {
+        /* Truncated stream */
+        status = BL_ERR_FORMAT;
+    }
+    else
+    {
+        status      = BootLz_Flush();
+        *image_size = s_lz.out_pos;
+    }
+
+    s_lz.active = 0U;
+
+    return status;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file BootProgress.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Persistent per-sector download progress for resumable transfers
+ * @version 0.1
+ * @date 2026-02-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/BootProgress.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/app.h"
+#include "incl/Crc32.h"
+#include "incl/FLASH.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTPROGRESS_ENTRY_BASE    (BOOTPROGRESS_BASE_ADDR + sizeof(BootProgress_Header_t))
+#define BOOTPROGRESS_ENTRY_SIZE    (FTFC_WRITE_DOUBLE_WORD)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Progress log header (two program phrases)
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t slot;
+    uint32_t base_sequence;
+    uint32_t header_crc;
+} BootProgress_Header_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t BootProgress_SectorCrc(uint32_t sector);
+static uint32_t BootProgress_SectorAddr(uint32_t sector);
+static void     BootProgress_StartNew(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t  s_slot     = BOOTSLOT_NONE;
+static uint32_t s_base_seq = 0U;
+static uint32_t s_done[BOOTPROGRESS_BITMAP_WORDS];
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Get P-Flash address of a sector of the open slot
+ *
+ * @param sector Sector index within the slot
+ * @return uint32_t Sector address
+ */
+static uint32_t BootProgress_SectorAddr(uint32_t sector)
+{
+    return (BootSlot_GetBaseAddr(s_slot) + (sector * BOOTSLOT_SECTOR_SIZE));
+}
+
+/**
+ * @brief CRC-32 of the current flash content of a sector
+ *
+ * @param sector Sector index within the slot
+ * @return uint32_t CRC-32
+ */
+static uint32_t BootProgress_SectorCrc(uint32_t sector)
+{
+    return Crc32_Compute((const uint8_t *)BootProgress_SectorAddr(sector), BOOTSLOT_SECTOR_SIZE);
+}
+
+/**
+ * @brief Erase the log and write a fresh header for the open slot
+ */
+static void BootProgress_StartNew(void)
+{
+    BootProgress_Header_t hdr;
+
+    (void)Erase_Sector(BOOTPROGRESS_BASE_ADDR);
+    (void)memset(s_done, 0, sizeof(s_done));
+
+    hdr.magic         = BOOTPROGRESS_HEADER_MAGIC;
+    hdr.slot          = (uint32_t)s_slot;
+    hdr.base_sequence = s_base_seq;
+    hdr.header_crc    = Crc32_Compute((const uint8_t *)&hdr, offsetof(BootProgress_Header_t, header_crc));
+
+    (void)Program_LongWord_8B(BOOTPROGRESS_BASE_ADDR, (uint8_t *)&hdr);
+    (void)Program_LongWord_8B(BOOTPROGRESS_BASE_ADDR + 8U, ((uint8_t *)&hdr) + 8U);
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Open the progress log for a download into a slot
+ *
+ * If the log belongs to the same slot and base image, sectors with an entry
+ * whose CRC still matches the flash content are kept as done. Otherwise a new
+ * log is started.
+ *
+ * @param slot Target slot
+ * @param base_sequence Sequence of the active slot when the download started
+ * @return uint8_t 1: previous download resumed, 0: new download
+ */
+uint8_t BootProgress_Open(uint8_t slot, uint32_t base_sequence)
+{
+    BootProgress_Header_t hdr;
+    uint32_t             *words = (uint32_t *)&hdr;
+    uint32_t              addr;
+    uint32_t              i;
+    uint8_t               resumed = 0U;
+
+    s_slot     = slot;
+    s_base_seq = base_sequence;
+    (void)memset(s_done, 0, sizeof(s_done));
+
+    for (i = 0U; i < (sizeof(hdr) / 4U); i++)
+    {
+        words[i] = Read_FlashAddress(BOOTPROGRESS_BASE_ADDR + (i * 4U));
+    }
+
+    if ((BOOTPROGRESS_HEADER_MAGIC == hdr.magic) &&
+        ((uint32_t)slot == hdr.slot) &&
+        (base_sequence == hdr.base_sequence) &&
+        (Crc32_Compute((const uint8_t *)&hdr, offsetof(BootProgress_Header_t, header_crc)) == hdr.header_crc))
+    {
+        resumed = 1U;
+
+        for (i = 0U; i < BOOTSLOT_SECTOR_COUNT; i++)
+        {
+            addr = BOOTPROGRESS_ENTRY_BASE + (i * BOOTPROGRESS_ENTRY_SIZE);
+
+            if (((BOOTPROGRESS_ENTRY_TAG | i) == Read_FlashAddress(addr)) &&
+                (BootProgress_SectorCrc(i) == Read_FlashAddress(addr + 4U)))
+            {
+                s_done[i / 32U] |= (1UL << (i % 32U));
+            }
+        }
+    }
+    else
+    {
+        BootProgress_StartNew();
+    }
+
+    return resumed;
+}
+
+/**
+ * @brief Drop all progress and start a new log for the same slot
+ */
+void BootProgress_Discard(void)
+{
+    if (BOOTSLOT_NONE != s_slot)
+    {
+        BootProgress_StartNew();
+    }
+}
+
+/**
+ * @brief Close the log once the image has been committed
+ */
+void BootProgress_Close(void)
+{
+    (void)Erase_Sector(BOOTPROGRESS_BASE_ADDR);
+    (void)memset(s_done, 0, sizeof(s_done));
+    s_slot = BOOTSLOT_NONE;
+}
+
+/**
+ * @brief Check if a sector is already programmed and verified
+ *
+ * @param sector Sector index within the slot
+ * @return uint8_t 1: done, 0: missing
+ */
+uint8_t BootProgress_IsDone(uint32_t sector)
+{
+    uint8_t done = 0U;
+
+    if (sector < BOOTSLOT_SECTOR_COUNT)
+    {
+        done = (uint8_t)((s_done[sector / 32U] >> (sector % 32U)) & 1UL);
+    }
+
+    return done;
+}
+
+/**
+ * @brief Persist a sector as programmed and verified
+ *
+ * @param sector Sector index within the slot
+ */
+void BootProgress_MarkDone(uint32_t sector)
+{
+    uint32_t entry[2U];
+    uint32_t addr;
+
+    if ((BOOTSLOT_NONE != s_slot) && (sector < BOOTSLOT_SECTOR_COUNT) && (0U == BootProgress_IsDone(sector)))
+    {
+        addr = BOOTPROGRESS_ENTRY_BASE + (sector * BOOTPROGRESS_ENTRY_SIZE);
+
+        /* A stale entry cannot be reprogrammed, the sector is redone on the next resume */
+        if ((0xFFFFFFFFUL == Read_FlashAddress(addr)) && (0xFFFFFFFFUL == Read_FlashAddress(addr + 4U)))
+        {
+            entry[0] = BOOTPROGRESS_ENTRY_TAG | sector;
+            entry[1] = BootProgress_SectorCrc(sector);
+
+            (void)Program_LongWord_8B(addr, (uint8_t *)entry);
+        }
+
+        s_done[sector / 32U] |= (1UL << (sector % 32U));
+    }
+}
+
+/**
+ * @brief Get number of sectors already done
+ *
+ * @return uint32_t Sector count
+ */
+uint32_t BootProgress_GetDoneCount(void)
+{
+    uint32_t count = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < BOOTSLOT_SECTOR_COUNT; i++)
+    {
+        count += (uint32_t)BootProgress_IsDone(i);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get end address (exclusive) of the highest done sector
+ *
+ * @return uint32_t End address, or slot base if nothing is done
+ */
+uint32_t BootProgress_GetEndAddr(void)
+{
+    uint32_t end = BootSlot_GetBaseAddr(s_slot);
+    uint32_t i;
+
+    for (i = 0U; i < BOOTSLOT_SECTOR_COUNT; i++)
+    {
+        if (0U != BootProgress_IsDone(i))
+        {
+            end = BootProgress_SectorAddr(i + 1U);
+        }
+    }
+
+    return end;
+}
+
+/**
+ * @brief Report missing ranges to the host
+ *
+ * One "MISSING <start> <end_exclusive>" line per run of missing sectors,
+ * followed by "END". The host sends only the records inside these ranges.
+ */
+void BootProgress_Report(void)
+{
+    uint32_t i;
+    uint32_t run_start = 0U;
+    uint8_t  in_run    = 0U;
+
+    for (i = 0U; i <= BOOTSLOT_SECTOR_COUNT; i++)
+    {
+        if ((i < BOOTSLOT_SECTOR_COUNT) && (0U == BootProgress_IsDone(i)))
+        {
+            if (0U == in_run)
+            {
+                run_start = i;
+                in_run    = 1U;
+            }
+        }
+        else if (0U != in_run)
+        {
+            App_SendString("MISSING ");
+            App_SendHex32(BootProgress_SectorAddr(run_start));
+            App_SendString(" ");
+            App_SendHex32(BootProgress_SectorAddr(i));
+            App_SendString("\r\n");
+            in_run = 0U;
+        }
+        else
+        {
+            /* Inside a run of done sectors */
+        }
+    }
+
+    App_SendString("END\r\n");
+}
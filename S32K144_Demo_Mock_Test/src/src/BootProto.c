@@ -0,0 +1,215 @@
+/**
+ * @file BootProto.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Windowed ACK/NAK transfer protocol for the UART bootloader
+ * @version 0.1
+ * @date 2026-02-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/BootProto.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/app.h"
+#include "incl/Bootloader.h"
+#include "incl/srec.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTPROTO_HEADER_LEN       (3U)   /* '@' + SS */
+#define BOOTPROTO_TRAILER_LEN      (2U)   /* CC */
+
+#define BOOTPROTO_REPLY_ACK        ('A')
+#define BOOTPROTO_REPLY_NAK        ('N')
+#define BOOTPROTO_REPLY_ERR        ('E')
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Receive window slot
+ */
+typedef struct
+{
+    uint8_t  data[BOOTPROTO_MAX_PAYLOAD];
+    uint32_t length;
+    uint8_t  used;
+} BootProto_Slot_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void BootProto_Reply(char kind, uint8_t seq);
+static void BootProto_Drain(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static BootProto_Slot_t    s_window[BOOTPROTO_WINDOW_SIZE];
+static BootProto_Deliver_t s_deliver  = NULL;
+static uint8_t             s_next_seq = 0U;
+static uint8_t             s_nak_sent = 0U;
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Send one reply line "Kss"
+ *
+ * @param kind Reply kind (A/N/E)
+ * @param seq Sequence number
+ */
+static void BootProto_Reply(char kind, uint8_t seq)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char              buf[6];
+
+    buf[0] = kind;
+    buf[1] = hex[(seq >> 4U) & 0x0FU];
+    buf[2] = hex[seq & 0x0FU];
+    buf[3] = '\r';
+    buf[4] = '\n';
+    buf[5] = '\0';
+
+    App_SendString(buf);
+}
+
+/**
+ * @brief Deliver buffered frames while the next expected one is present
+ */
+static void BootProto_Drain(void)
+{
+    BootProto_Slot_t *slot = &s_window[s_next_seq % BOOTPROTO_WINDOW_SIZE];
+    int32_t           status;
+
+    while (0U != slot->used)
+    {
+        status     = s_deliver(slot->data, slot->length);
+        slot->used = 0U;
+
+        if (BL_OK != status)
+        {
+            BootProto_Reply(BOOTPROTO_REPLY_ERR, s_next_seq);
+        }
+
+        s_next_seq++;
+        s_nak_sent = 0U;
+        slot       = &s_window[s_next_seq % BOOTPROTO_WINDOW_SIZE];
+    }
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Reset the receive window
+ *
+ * @param deliver Payload consumer
+ */
+void BootProto_Init(BootProto_Deliver_t deliver)
+{
+    (void)memset(s_window, 0, sizeof(s_window));
+
+    s_deliver  = deliver;
+    s_next_seq = 0U;
+    s_nak_sent = 0U;
+}
+
+/**
+ * @brief Handle one received frame line
+ *
+ * @param frame Pointer to frame (starting with '@')
+ * @param len Frame length (without CR/LF)
+ */
+void BootProto_HandleFrame(const uint8_t *frame, uint32_t len)
+{
+    uint8_t           seq      = 0U;
+    uint8_t           check    = 0U;
+    uint8_t           sum      = 0U;
+    uint8_t           valid    = 0U;
+    uint8_t           distance;
+    uint32_t          payload_len;
+    uint32_t          i;
+    BootProto_Slot_t *slot;
+
+    if ((NULL == frame) || (NULL == s_deliver))
+    {
+        return;
+    }
+
+    payload_len = (len >= (BOOTPROTO_HEADER_LEN + BOOTPROTO_TRAILER_LEN))
+                ? (len - BOOTPROTO_HEADER_LEN - BOOTPROTO_TRAILER_LEN) : 0U;
+
+    if ((0U != payload_len) &&
+        (payload_len < BOOTPROTO_MAX_PAYLOAD) &&
+        (BOOTPROTO_FRAME_START == frame[0]) &&
+        (SREC_STATUS_OK == Srec_HexToByte(frame[1], frame[2], &seq)) &&
+        (SREC_STATUS_OK == Srec_HexToByte(frame[len - 2U], frame[len - 1U], &check)))
+    {
+        sum = seq;
+        for (i = 0U; i < payload_len; i++)
+        {
+            sum = (uint8_t)(sum + frame[BOOTPROTO_HEADER_LEN + i]);
+        }
+
+        if ((uint8_t)0xFFU == (uint8_t)(sum + check))
+        {
+            valid = 1U;
+        }
+    }
+
+    if (0U == valid)
+    {
+        /* Sequence number cannot be trusted: ask for the oldest missing frame */
+        if (0U == s_nak_sent)
+        {
+            BootProto_Reply(BOOTPROTO_REPLY_NAK, s_next_seq);
+            s_nak_sent = 1U;
+        }
+    }
+    else
+    {
+        distance = (uint8_t)(seq - s_next_seq);
+
+        if (distance < BOOTPROTO_WINDOW_SIZE)
+        {
+            slot = &s_window[seq % BOOTPROTO_WINDOW_SIZE];
+
+            if (0U == slot->used)
+            {
+                (void)memcpy(slot->data, &frame[BOOTPROTO_HEADER_LEN], payload_len);
+                slot->data[payload_len] = (uint8_t)'\0';
+                slot->length            = payload_len;
+                slot->used              = 1U;
+            }
+
+            BootProto_Reply(BOOTPROTO_REPLY_ACK, seq);
+
+            if (0U == distance)
+            {
+                BootProto_Drain();
+            }
+            else
+            {
+                /* Gap in front of this frame */
+                if (0U == s_nak_sent)
+                {
+                    BootProto_Reply(BOOTPROTO_REPLY_NAK, s_next_seq);
+                    s_nak_sent = 1U;
+                }
+            }
+        }
+        else if (distance >= (uint8_t)(256U - BOOTPROTO_WINDOW_SIZE))
+        {
+            /* Already handled, the host missed the ACK */
+            BootProto_Reply(BOOTPROTO_REPLY_ACK, seq);
+        }
+        else
+        {
+            /* Outside the window: host is out of sync, drop */
+        }
+    }
+}
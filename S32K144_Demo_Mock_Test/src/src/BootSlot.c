@@ -0,0 +1,275 @@
+/**
+ * @file BootSlot.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief A/B application slot management for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-02
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/BootSlot.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/Bootloader.h"
+#include "incl/Crc32.h"
+#include "incl/FLASH.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTSLOT_RECORD_WORDS      (sizeof(BootSlot_Record_t) / 4U)
+#define BOOTSLOT_RECORD_CRC_LEN    (offsetof(BootSlot_Record_t, record_crc))
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t BootSlot_GetMetaAddr(uint8_t slot);
+static void     BootSlot_ReadRecord(uint8_t slot, BootSlot_Record_t *rec);
+static uint8_t  BootSlot_IsRecordValid(uint8_t slot, const BootSlot_Record_t *rec);
+static uint8_t  BootSlot_IsNewer(uint32_t seq, uint32_t than);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t  s_active_slot = BOOTSLOT_NONE;
+static uint32_t s_active_seq  = 0U;
+
+/*******************************************************************************
+ * Local functions
+ ******************************************************************************/
+/**
+ * @brief Get D-Flash address of the status record of a slot
+ *
+ * @param slot Slot index
+ * @return uint32_t Record address
+ */
+static uint32_t BootSlot_GetMetaAddr(uint8_t slot)
+{
+    return (BOOTSLOT_META_BASE_ADDR + ((uint32_t)slot * BOOTSLOT_META_SECTOR_SIZE));
+}
+
+/**
+ * @brief Copy the status record of a slot from D-Flash
+ *
+ * @param slot Slot index
+ * @param rec Output record
+ */
+static void BootSlot_ReadRecord(uint8_t slot, BootSlot_Record_t *rec)
+{
+    uint32_t  base  = BootSlot_GetMetaAddr(slot);
+    uint32_t *words = (uint32_t *)rec;
+    uint32_t  i;
+
+    for (i = 0U; i < BOOTSLOT_RECORD_WORDS; i++)
+    {
+        words[i] = Read_FlashAddress(base + (i * 4U));
+    }
+}
+
+/**
+ * @brief Check a slot status record
+ *
+ * @param slot Slot index the record was read from
+ * @param rec Record to check
+ * @return uint8_t 1: valid, 0: invalid (erased, torn or foreign)
+ */
+static uint8_t BootSlot_IsRecordValid(uint8_t slot, const BootSlot_Record_t *rec)
+{
+    uint8_t valid = 0U;
+
+    if ((BOOTSLOT_RECORD_MAGIC == rec->magic) &&
+        ((uint32_t)slot == rec->slot) &&
+        (0U != rec->image_size) &&
+        (rec->image_size <= BOOTSLOT_SIZE) &&
+        (Crc32_Compute((const uint8_t *)rec, BOOTSLOT_RECORD_CRC_LEN) == rec->record_crc))
+    {
+        valid = 1U;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Compare sequence numbers (wrap-around safe)
+ *
+ * @param seq Sequence to test
+ * @param than Reference sequence
+ * @return uint8_t 1: seq is newer than reference
+ */
+static uint8_t BootSlot_IsNewer(uint32_t seq, uint32_t than)
+{
+    return (((int32_t)(seq - than)) > 0) ? 1U : 0U;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Select the active slot: newest valid status record wins
+ *
+ * Only the two fixed-size records are read, the images are not scanned.
+ */
+void BootSlot_Init(void)
+{
+    BootSlot_Record_t rec;
+    uint8_t           slot;
+
+    s_active_slot = BOOTSLOT_NONE;
+    s_active_seq  = 0U;
+
+    for (slot = 0U; slot < BOOTSLOT_COUNT; slot++)
+    {
+        BootSlot_ReadRecord(slot, &rec);
+
+        if (0U != BootSlot_IsRecordValid(slot, &rec))
+        {
+            if ((BOOTSLOT_NONE == s_active_slot) || (0U != BootSlot_IsNewer(rec.sequence, s_active_seq)))
+            {
+                s_active_slot = slot;
+                s_active_seq  = rec.sequence;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the slot to boot
+ *
+ * @return uint8_t Slot index or BOOTSLOT_NONE
+ */
+uint8_t BootSlot_GetActive(void)
+{
+    return s_active_slot;
+}
+
+/**
+ * @brief Get the sequence number of the active slot
+ *
+ * @return uint32_t Sequence (0 if no slot is active)
+ */
+uint32_t BootSlot_GetActiveSequence(void)
+{
+    return s_active_seq;
+}
+
+/**
+ * @brief Get the slot a download goes to (never the active one)
+ *
+ * @return uint8_t Slot index
+ */
+uint8_t BootSlot_GetTarget(void)
+{
+    uint8_t target = BOOTSLOT_A;
+
+    if (BOOTSLOT_A == s_active_slot)
+    {
+        target = BOOTSLOT_B;
+    }
+
+    return target;
+}
+
+/**
+ * @brief Get base address of a slot
+ *
+ * @param slot Slot index
+ * @return uint32_t Base address
+ */
+uint32_t BootSlot_GetBaseAddr(uint8_t slot)
+{
+    return (BOOTSLOT_B == slot) ? BOOTSLOT_B_BASE_ADDR : BOOTSLOT_A_BASE_ADDR;
+}
+
+/**
+ * @brief Get end address (exclusive) of a slot
+ *
+ * @param slot Slot index
+ * @return uint32_t End address (exclusive)
+ */
+uint32_t BootSlot_GetEndAddrExcl(uint8_t slot)
+{
+    return (BootSlot_GetBaseAddr(slot) + BOOTSLOT_SIZE);
+}
+
+/**
+ * @brief Prepare the target slot: invalidate its status record
+ *
+ * The slot itself is erased sector by sector while the image streams in,
+ * so sectors kept by a resumed download are not wiped. The active slot is
+ * not touched.
+ *
+ * @return int32_t BL_OK or BL_ERR_FLASH
+ */
+int32_t BootSlot_BeginDownload(void)
+{
+    int32_t  status = BL_OK;
+    uint32_t meta   = BootSlot_GetMetaAddr(BootSlot_GetTarget());
+
+    if (0xFFFFFFFFUL != Read_FlashAddress(meta))
+    {
+        (void)Erase_Sector(meta);
+
+        if (0xFFFFFFFFUL != Read_FlashAddress(meta))
+        {
+            status = BL_ERR_FLASH;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Commit the downloaded image: write the target slot record
+ *
+ * Writing the record is the switchover point, the new slot carries the
+ * next sequence number and wins on the next BootSlot_Init().
+ *
+ * @param image_size Number of bytes programmed from the slot base
+ * @return int32_t BL_OK, BL_ERR_PARAM or BL_ERR_VERIFY
+ */
+int32_t BootSlot_Commit(uint32_t image_size)
+{
+    int32_t           status = BL_OK;
+    uint8_t           target = BootSlot_GetTarget();
+    uint32_t          meta   = BootSlot_GetMetaAddr(target);
+    BootSlot_Record_t rec;
+    BootSlot_Record_t check;
+    uint32_t          off;
+
+    if ((0U == image_size) || (image_size > BOOTSLOT_SIZE))
+    {
+        status = BL_ERR_PARAM;
+    }
+    else
+    {
+        (void)memset(&rec, 0xFF, sizeof(rec));
+
+        rec.magic      = BOOTSLOT_RECORD_MAGIC;
+        rec.slot       = (uint32_t)target;
+        rec.sequence   = s_active_seq + 1U;
+        rec.image_size = image_size;
+        rec.image_crc  = Crc32_Compute((const uint8_t *)BootSlot_GetBaseAddr(target), image_size);
+        rec.record_crc = Crc32_Compute((const uint8_t *)&rec, BOOTSLOT_RECORD_CRC_LEN);
+
+        for (off = 0U; off < sizeof(rec); off += FTFC_WRITE_DOUBLE_WORD)
+        {
+            (void)Program_LongWord_8B(meta + off, ((uint8_t *)&rec) + off);
+        }
+
+        BootSlot_ReadRecord(target, &check);
+
+        if ((0U == BootSlot_IsRecordValid(target, &check)) || (check.image_crc != rec.image_crc))
+        {
+            status = BL_ERR_VERIFY;
+        }
+        else
+        {
+            s_active_slot = target;
+            s_active_seq  = rec.sequence;
+        }
+    }
+
+    return status;
+}
@@ -10,14 +10,23 @@
 #include "s32_core_cm4.h"
 #include "S32K144_features.h"
 #include "S32K144.h"
+#include "system_S32K144.h"
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
 #include "incl/app.h"
+#include "incl/Bench.h"
+#include "incl/BootBench.h"
+#include "incl/BootDelta.h"
+#include "incl/BootLz.h"
+#include "incl/BootProgress.h"
+#include "incl/BootSlot.h"
 #include "incl/Driver_USART.h"
 #include "incl/FLASH.h"
 #include "incl/NVIC.h"
 #include "incl/srec.h"
+#include "TimeBase.h"
+#include "incl/Trace.h"
 
 /*******************************************************************************
  * Definitions
@@ -28,13 +37,28 @@
 #define S32K144_FLASH_START       (0x00000000UL)
 #define S32K144_FLASH_END_EXCL    (0x00080000UL) /* end-exclusive */
 
-#define BOOTLOADER_SIZE           (0xA000UL)      /* bootloader size */
-#define APP_START_ADDR            (S32K144_FLASH_START + BOOTLOADER_SIZE)
-#define APP_END_EXCL              (S32K144_FLASH_END_EXCL)
-
 #define FLASH_SECTOR_SIZE         (FTFC_P_FLASH_SECTOR_SIZE)
 
 #define PHRASE_SIZE               (FTFC_WRITE_DOUBLE_WORD) /* 8 bytes */
+#define PHRASE_BATCH_PHRASES      (64U)  /* phrases per Flash_ProgramBatch call */
+#define PHRASE_BATCH_RUNS         (8U)   /* contiguous runs per call */
+
+#define BOOTLOADER_NO_SECTOR      (0xFFFFFFFFUL)
+
+/* How data records are interpreted */
+#define BOOTLOADER_MODE_PLAIN     (0U)   /* address + image bytes */
+#define BOOTLOADER_MODE_DELTA     (1U)   /* delta stream (BootDelta) */
+#define BOOTLOADER_MODE_LZ        (2U)   /* compressed stream (BootLz) */
+
+#define BOOTLOADER_NAME_MAX       (32U)
+
+#define BOOTLOADER_CMD_PROGRESS   "#PROGRESS"
+#define BOOTLOADER_CMD_RESTART    "#RESTART"
+#define BOOTLOADER_CMD_DELTA      "#DELTA"
+#define BOOTLOADER_CMD_LZ         "#LZ"
+#define BOOTLOADER_CMD_BENCH      "#BENCH"
+#define BOOTLOADER_CMD_TRACE      "#TRACE"
+#define BOOTLOADER_CMD_FLASHSTATS "#FLASHSTATS"
 
 /*******************************************************************************
  * Types
@@ -50,24 +74,73 @@
     uint8_t  dirty;
 } phrase_cache_t;
 
+/**
+ * @brief Phrases waiting for one RAM kernel call, all in the current sector
+ */
+typedef struct
+{
+    uint32_t            data[(PHRASE_BATCH_PHRASES * PHRASE_SIZE) / 4U]; /* word aligned */
+    Flash_ProgramDesc_t desc[PHRASE_BATCH_RUNS];
+    uint32_t            phrases;
+    uint32_t            runs;
+} phrase_batch_t;
+
+/**
+ * @brief Statistics of the transfer in progress
+ */
+typedef struct
+{
+    uint64_t start_cycles;
+    uint32_t records;                       /* S1/S2/S3 records handled without error */
+    uint32_t bytes;                         /* data bytes of those records */
+    uint32_t flash_cmds;                    /* Flash_GetCommandCount() at start */
+    uint8_t  active;
+    uint8_t  count_error;                   /* S5/S6 did not match */
+    char     name[BOOTLOADER_NAME_MAX + 1U]; /* S0 module name/version */
+} transfer_stats_t;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 static void    PhraseCache_Reset(phrase_cache_t *c);
 static int32_t PhraseCache_Flush(phrase_cache_t *c);
 
+static void           PhraseBatch_Reset(void);
+static const uint8_t *PhraseBatch_Find(uint32_t base);
+static int32_t        PhraseBatch_Add(uint32_t base, const uint8_t *buf8);
+static int32_t        PhraseBatch_Flush(void);
+
 static void    Bootloader_StreamBegin(void);
 static int32_t Bootloader_StreamEnd(void);
 static int32_t Bootloader_StreamWrite(uint32_t address, const uint8_t *data, uint32_t len);
 
 static uint8_t Bootloader_IsAddressInRange(uint32_t addr, uint32_t start, uint32_t end_exclusive);
 static uint8_t PhraseCache_IsAlreadyProgrammedSame(uint32_t base, const uint8_t *buf8);
+static int32_t Bootloader_PrepareSector(uint32_t base);
+static void    Bootloader_CompleteSector(void);
+static uint8_t Bootloader_IsCommand(const uint8_t *line, uint32_t len, const char *cmd);
+static int32_t Bootloader_CommitImage(uint32_t image_end);
+static void    Bootloader_TransferStart(void);
+static void    Bootloader_TransferHeader(const srec_view_t *record);
+static void    Bootloader_TransferSummary(void);
+static void    Bootloader_ReportFlashStats(void);
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 static phrase_cache_t g_cache;
+static phrase_batch_t g_batch;
 static uint8_t        g_cache_inited = 0U;
+static uint32_t       g_image_end    = 0U;   /* highest programmed address (exclusive) */
+static uint32_t       g_cur_sector   = BOOTLOADER_NO_SECTOR;
+static uint8_t        g_record_mode  = BOOTLOADER_MODE_PLAIN;
+static uint32_t       g_sector_erased[BOOTPROGRESS_BITMAP_WORDS]; /* erased in this session */
+static transfer_stats_t g_xfer;
+
+static const uint8_t  g_erased_phrase[PHRASE_SIZE] =
+{
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+};
 
 /*******************************************************************************
  * Local functions
@@ -150,15 +223,198 @@ static uint8_t PhraseCache_IsAlreadyProgrammedSame(uint32_t base, const uint8_t
     return same;
 }
 
+/**
+ * @brief Drop the phrases waiting for programming
+ */
+static void PhraseBatch_Reset(void)
+{
+    g_batch.phrases = 0U;
+    g_batch.runs    = 0U;
+}
+
+/**
+ * @brief Find a phrase waiting for programming
+ *
+ * @param base base address of the phrase
+ * @return const uint8_t* pending data, NULL if the phrase is not pending
+ */
+static const uint8_t *PhraseBatch_Find(uint32_t base)
+{
+    const uint8_t *pending = NULL;
+    uint32_t       i;
+
+    for (i = 0U; i < g_batch.runs; i++)
+    {
+        if ((base >= g_batch.desc[i].Addr) &&
+            (base < (g_batch.desc[i].Addr + (g_batch.desc[i].Phrases * PHRASE_SIZE))))
+        {
+            pending = &g_batch.desc[i].Src[base - g_batch.desc[i].Addr];
+            break;
+        }
+    }
+
+    return pending;
+}
+
+/**
+ * @brief Program and read back the pending phrases with one RAM kernel call
+ *
+ * @return int32_t status
+ */
+static int32_t PhraseBatch_Flush(void)
+{
+    int32_t  status = BL_OK;
+    uint32_t i;
+    uint32_t p;
+
+    if (0U != g_batch.runs)
+    {
+        if (0U == Flash_ProgramBatch(g_batch.desc, g_batch.runs))
+        {
+            status = BL_ERR_FLASH;
+        }
+
+        for (i = 0U; (BL_OK == status) && (i < g_batch.runs); i++)
+        {
+            for (p = 0U; p < g_batch.desc[i].Phrases; p++)
+            {
+                if (0U == PhraseCache_IsAlreadyProgrammedSame(g_batch.desc[i].Addr + (p * PHRASE_SIZE),
+                                                              &g_batch.desc[i].Src[p * PHRASE_SIZE]))
+                {
+                    status = BL_ERR_VERIFY;
+                    break;
+                }
+            }
+        }
+    }
+
+    PhraseBatch_Reset();
+
+    return status;
+}
+
+/**
+ * @brief Queue an erased phrase for programming
+ *
+ * Contiguous phrases share a descriptor; a full batch is flushed first.
+ *
+ * @param base base address of the phrase
+ * @param buf8 phrase data
+ * @return int32_t status of the flush a full batch needed
+ */
+static int32_t PhraseBatch_Add(uint32_t base, const uint8_t *buf8)
+{
+    int32_t              status = BL_OK;
+    uint8_t             *dst;
+    Flash_ProgramDesc_t *last   = (0U != g_batch.runs) ? &g_batch.desc[g_batch.runs - 1U] : NULL;
+    uint8_t              extend = ((NULL != last) &&
+                                   ((last->Addr + (last->Phrases * PHRASE_SIZE)) == base)) ? 1U : 0U;
+
+    if ((PHRASE_BATCH_PHRASES == g_batch.phrases) ||
+        ((0U == extend) && (PHRASE_BATCH_RUNS == g_batch.runs)))
+    {
+        status = PhraseBatch_Flush();
+        extend = 0U;
+    }
+
+    if (BL_OK == status)
+    {
+        dst = (uint8_t *)&g_batch.data[(g_batch.phrases * PHRASE_SIZE) / 4U];
+        (void)memcpy(dst, buf8, PHRASE_SIZE);
+
+        if (0U != extend)
+        {
+            /* Phrases of the last run are stored back to back */
+            last->Phrases++;
+        }
+        else
+        {
+            g_batch.desc[g_batch.runs].Addr    = base;
+            g_batch.desc[g_batch.runs].Src     = dst;
+            g_batch.desc[g_batch.runs].Phrases = 1U;
+            g_batch.runs++;
+        }
+
+        g_batch.phrases++;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Mark the sector being streamed as done once the stream leaves it
+ */
+static void Bootloader_CompleteSector(void)
+{
+    if (BOOTLOADER_NO_SECTOR != g_cur_sector)
+    {
+        if (0UL != (g_sector_erased[g_cur_sector / 32U] & (1UL << (g_cur_sector % 32U))))
+        {
+            BootProgress_MarkDone(g_cur_sector);
+        }
+
+        g_cur_sector = BOOTLOADER_NO_SECTOR;
+    }
+}
+
+/**
+ * @brief Track the sector of a phrase and erase it on first use
+ *
+ * Sectors already done by a previous (resumed) download are never erased.
+ *
+ * @param base phrase base address
+ * @return int32_t status
+ */
+static int32_t Bootloader_PrepareSector(uint32_t base)
+{
+    int32_t  status    = BL_OK;
+    uint32_t slot_base = BootSlot_GetBaseAddr(BootSlot_GetTarget());
+    uint32_t sector    = (base - slot_base) / FLASH_SECTOR_SIZE;
+    uint32_t mask      = 1UL << (sector % 32U);
+
+    if (sector != g_cur_sector)
+    {
+        /* The sector left is done once its pending phrases are verified */
+        status = PhraseBatch_Flush();
+        if (BL_OK == status)
+        {
+            Bootloader_CompleteSector();
+        }
+        g_cur_sector = sector;
+    }
+
+    if ((BL_OK == status) && (0U == BootProgress_IsDone(sector)) && (0UL == (g_sector_erased[sector / 32U] & mask)))
+    {
+        g_sector_erased[sector / 32U] |= mask;
+
+        if ((0U == Erase_Sector(slot_base + (sector * FLASH_SECTOR_SIZE))) ||
+            (0U == PhraseCache_IsAlreadyProgrammedSame(base, g_erased_phrase)))
+        {
+            status = BL_ERR_FLASH;
+        }
+    }
+
+    return status;
+}
+
 /**
  * @brief Flush phrase cache to flash
  *
+ * The phrase is skipped if flash (or the batch) already holds the same data
+ * and queued for programming only over an erased phrase. The batch is
+ * programmed and read back when the stream leaves the sector, when it is
+ * full and at the end of the stream, so a program error is reported by the
+ * record that triggers that flush.
+ *
  * @param c phrase cache to flush
  * @return int32_t status
  */
 static int32_t PhraseCache_Flush(phrase_cache_t *c)
 {
-    int32_t status = BL_OK;
+    int32_t        status  = BL_OK;
+    const uint8_t *pending = NULL;
+
+    TRACE_EVENT(TRACE_ID_FLUSH_BEGIN, (NULL != c) ? c->base : 0U);
 
     if ((NULL == c) || (0U == c->valid) || (0U == c->dirty))
     {
@@ -166,20 +422,47 @@ static int32_t PhraseCache_Flush(phrase_cache_t *c)
     }
     else
     {
-        if (0U != PhraseCache_IsAlreadyProgrammedSame(c->base, c->data))
+        status = Bootloader_PrepareSector(c->base);
+
+        if (BL_OK == status)
+        {
+            pending = PhraseBatch_Find(c->base);
+        }
+
+        if (BL_OK != status)
+        {
+            /* Erase or flush of the previous sector failed */
+        }
+        else if (NULL != pending)
+        {
+            /* Written again before the batch was flushed */
+            if (0 == memcmp(pending, c->data, PHRASE_SIZE))
+            {
+                c->dirty = 0U;
+            }
+            else
+            {
+                status = BL_ERR_VERIFY;
+            }
+        }
+        else if (0U != PhraseCache_IsAlreadyProgrammedSame(c->base, c->data))
         {
             c->dirty = 0U;
-            status = BL_OK;
+        }
+        else if (0U == PhraseCache_IsAlreadyProgrammedSame(c->base, g_erased_phrase))
+        {
+            /* Programmed with other data, cannot be overwritten */
+            status = BL_ERR_VERIFY;
         }
         else
         {
-            (void)Program_LongWord_8B(c->base, c->data);
-
             c->dirty = 0U;
-            status = BL_OK;
+            status   = PhraseBatch_Add(c->base, c->data);
         }
     }
 
+    TRACE_EVENT(TRACE_ID_FLUSH_END, status);
+
     return status;
 }
 
@@ -189,7 +472,12 @@ static int32_t PhraseCache_Flush(phrase_cache_t *c)
 static void Bootloader_StreamBegin(void)
 {
     PhraseCache_Reset(&g_cache);
+    PhraseBatch_Reset();
     g_cache_inited = 1U;
+    g_image_end    = BootSlot_GetBaseAddr(BootSlot_GetTarget());
+    g_cur_sector   = BOOTLOADER_NO_SECTOR;
+
+    (void)memset(g_sector_erased, 0, sizeof(g_sector_erased));
 }
 
 /**
@@ -198,7 +486,22 @@ static void Bootloader_StreamBegin(void)
 static int32_t Bootloader_StreamEnd(void)
 {
     int32_t status = BL_OK;
-    status = PhraseCache_Flush(&g_cache);
+
+    /* Nothing may be pending when a resumed download only sends the terminator */
+    if (0U != g_cache.dirty)
+    {
+        status = PhraseCache_Flush(&g_cache);
+    }
+
+    if (BL_OK == status)
+    {
+        status = PhraseBatch_Flush();
+    }
+
+    if (BL_OK == status)
+    {
+        Bootloader_CompleteSector();
+    }
 
     return status;
 }
@@ -210,6 +513,7 @@ static int32_t Bootloader_StreamWrite(uint32_t address, const uint8_t *data, uin
 {
     int32_t  status   = BL_OK;
     uint32_t end_excl = 0U;
+    uint8_t  target   = BootSlot_GetTarget();
 
     if ((NULL == data) || (0UL == len))
     {
@@ -222,7 +526,7 @@ static int32_t Bootloader_StreamWrite(uint32_t address, const uint8_t *data, uin
         {
             status = BL_ERR_PARAM;
         }
-        else if ((address < APP_START_ADDR) || (end_excl > APP_END_EXCL))
+        else if ((address < BootSlot_GetBaseAddr(target)) || (end_excl > BootSlot_GetEndAddrExcl(target)))
         {
             status = BL_ERR_RANGE;
         }
@@ -260,12 +564,148 @@ static int32_t Bootloader_StreamWrite(uint32_t address, const uint8_t *data, uin
                 g_cache.data[off] = data[i];
                 g_cache.dirty = 1U;
             }
+
+            if ((BL_OK == status) && (end_excl > g_image_end))
+            {
+                g_image_end = end_excl;
+            }
         }
     }
 
     return status;
 }
 
+/**
+ * @brief Start collecting statistics on the first record of a transfer
+ */
+static void Bootloader_TransferStart(void)
+{
+    if (0U == g_xfer.active)
+    {
+        (void)memset(&g_xfer, 0, sizeof(g_xfer));
+
+        g_xfer.start_cycles = Bench_GetCycles();
+        g_xfer.flash_cmds   = Flash_GetCommandCount();
+        g_xfer.active       = 1U;
+    }
+}
+
+/**
+ * @brief Keep the printable part of the S0 header (module name/version)
+ *
+ * @param record S0 record view
+ */
+static void Bootloader_TransferHeader(const srec_view_t *record)
+{
+    uint32_t n = 0U;
+
+    for (uint32_t i = 0U; (i < record->data_len) && (n < BOOTLOADER_NAME_MAX); i++)
+    {
+        if ((record->data[i] >= 0x20U) && (record->data[i] < 0x7FU))
+        {
+            g_xfer.name[n] = (char)record->data[i];
+            n++;
+        }
+    }
+
+    g_xfer.name[n] = '\0';
+}
+
+/**
+ * @brief Print the one-line transfer summary and end the transfer
+ *
+ * SUMMARY <name> RECORDS r BYTES b FLASH f TICKS t HZ h BPS s (values in hex)
+ * TICKS are core cycles, HZ the core clock they count at.
+ */
+static void Bootloader_TransferSummary(void)
+{
+    uint64_t ticks = Bench_GetCycles() - g_xfer.start_cycles;
+    uint32_t bps   = 0U;
+
+    if (0ULL != ticks)
+    {
+        /* 80 MHz after NormalRUNmode_80MHz, 48 MHz when App_InitClock stayed on FIRC */
+        bps = (uint32_t)(((uint64_t)g_xfer.bytes * SystemCoreClock) / ticks);
+    }
+
+    App_SendString("SUMMARY ");
+    App_SendString((0 != g_xfer.name[0]) ? g_xfer.name : "-");
+    App_SendString(" RECORDS ");
+    App_SendHex32(g_xfer.records);
+    App_SendString(" BYTES ");
+    App_SendHex32(g_xfer.bytes);
+    App_SendString(" FLASH ");
+    App_SendHex32(Flash_GetCommandCount() - g_xfer.flash_cmds);
+    App_SendString(" TICKS ");
+    App_SendHex32((uint32_t)(ticks >> 32));
+    App_SendHex32((uint32_t)ticks);
+    App_SendString(" HZ ");
+    App_SendHex32(SystemCoreClock);
+    App_SendString(" BPS ");
+    App_SendHex32(bps);
+    App_SendString("\r\n");
+
+    g_xfer.active = 0U;
+}
+
+/**
+ * @brief Print the flash command statistics (values in hex, core cycles)
+ *
+ * FLASH <cmd> COUNT n ERRORS e MIN c MAX c TOTAL c
+ *   LOG2 b n                     one line per non-empty histogram bin
+ * FLASH FSTAT ACCERR a FPVIOL f MGSTAT0 m
+ */
+static void Bootloader_ReportFlashStats(void)
+{
+    static const char * const names[FLASH_CMD_KINDS] = { "PROGRAM", "ERASE_SECTOR", "ERASE_BLOCK" };
+    const Flash_Stats_t      *stats = Flash_GetStats();
+    const Flash_CmdStats_t   *cmd;
+    uint32_t                  kind;
+    uint32_t                  bin;
+
+    for (kind = 0U; kind < FLASH_CMD_KINDS; kind++)
+    {
+        cmd = &stats->Cmd[kind];
+
+        App_SendString("FLASH ");
+        App_SendString(names[kind]);
+        App_SendString(" COUNT ");
+        App_SendHex32(cmd->Count);
+        App_SendString(" ERRORS ");
+        App_SendHex32(cmd->Errors);
+        App_SendString(" MIN ");
+        App_SendHex32(cmd->MinCycles);
+        App_SendString(" MAX ");
+        App_SendHex32(cmd->MaxCycles);
+        App_SendString(" TOTAL ");
+        App_SendHex32((uint32_t)(cmd->TotalCycles >> 32));
+        App_SendHex32((uint32_t)cmd->TotalCycles);
+        App_SendString("\r\n");
+
+        for (bin = 0U; bin < FLASH_HIST_BINS; bin++)
+        {
+            if (0U != cmd->Hist[bin])
+            {
+                App_SendString("  LOG2 ");
+                App_SendHex32(bin);
+                App_SendString(" ");
+                App_SendHex32(cmd->Hist[bin]);
+                App_SendString("\r\n");
+            }
+        }
+    }
+
+    App_SendString("FLASH FSTAT ACCERR ");
+    App_SendHex32(stats->AccErr);
+    App_SendString(" FPVIOL ");
+    App_SendHex32(stats->FpViol);
+    App_SendString(" MGSTAT0 ");
+    App_SendHex32(stats->MgStat0);
+    App_SendString(" TIMEOUT ");
+    App_SendHex32(stats->Timeouts);
+    App_SendString("\r\n");
+}
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -326,6 +766,9 @@ void Bootloader_JumpToUserApp(uint32_t app_base_addr)
 
     DISABLE_INTERRUPTS();
 
+    /* Hand over with SysTick stopped, the application sets up its own */
+    Time_Deinit();
+
     /* Relocate vector table */
     S32_SCB->VTOR = app_base_addr;
 
@@ -342,47 +785,267 @@ void Bootloader_JumpToUserApp(uint32_t app_base_addr)
     }
 }
 
+/**
+ * @brief Validate the image in the target slot, commit it and boot it
+ *
+ * @param image_end End address (exclusive) of the image in the target slot
+ * @return int32_t error status (does not return on success)
+ */
+static int32_t Bootloader_CommitImage(uint32_t image_end)
+{
+    int32_t status = BL_OK;
+    uint8_t target = BootSlot_GetTarget();
+    uint8_t active;
+
+    /* Switch over only if the new image looks bootable */
+    if (0U != Bootloader_IsUserAppValid(BootSlot_GetBaseAddr(target)))
+    {
+        status = BootSlot_Commit(image_end - BootSlot_GetBaseAddr(target));
+    }
+    else
+    {
+        status = BL_ERR_VERIFY;
+    }
+
+    if (BL_OK == status)
+    {
+        BootProgress_Close();
+    }
+
+    active = BootSlot_GetActive();
+
+    if ((BL_OK == status) && (BOOTSLOT_NONE != active))
+    {
+        Bootloader_JumpToUserApp(BootSlot_GetBaseAddr(active));
+    }
+
+    return status;
+}
+
 /**
  * @brief Handle SREC record
  *
- * @param record Pointer to SREC record
+ * S0 names the module, S5/S6 must match the number of data records handled
+ * since the start of the transfer. After a resume the host sends only the
+ * missing ranges with a count of those records ("bltool resume"). The
+ * terminator prints a summary.
+ *
+ * @param record Pointer to record view (SREC or Intel HEX)
  * @param entry_point Pointer to entry point variable
+ * @return int32_t BL_OK, BL_ERR_COUNT, or the error of the stream/commit step
  */
-void Bootloader_HandleRecord(const srec_record_t *record, uint32_t *entry_point)
+int32_t Bootloader_HandleRecord(const srec_view_t *record, uint32_t *entry_point)
 {
-    int32_t flush_st = BL_OK;
+    int32_t  status = BL_OK;
+    uint32_t image_end;
+    uint32_t image_size;
 
     if ((NULL == record) || (NULL == entry_point))
     {
-        return;
+        status = BL_ERR_PARAM;
     }
-
-    switch (record->type)
+    else
     {
-        case '1':
-        case '2':
-        case '3':
-        {
-            Bootloader_StreamWrite(record->address, record->data, record->data_len);
-            break;
-        }
+        Bootloader_TransferStart();
 
-        case '7':
-        case '8':
-        case '9':
+        switch (record->type)
         {
-            flush_st = Bootloader_StreamEnd();
+            case '0':
+            {
+                Bootloader_TransferHeader(record);
+                break;
+            }
+
+            case '1':
+            case '2':
+            case '3':
+            {
+                if (BOOTLOADER_MODE_DELTA == g_record_mode)
+                {
+                    /* Address field is the offset in the delta stream */
+                    status = BootDelta_Write(record->address, record->data, record->data_len);
+                }
+                else if (BOOTLOADER_MODE_LZ == g_record_mode)
+                {
+                    /* Address field is the offset in the compressed stream */
+                    status = BootLz_Write(record->address, record->data, record->data_len);
+                }
+                else
+                {
+                    status = Bootloader_StreamWrite(record->address, record->data, record->data_len);
+                }
+
+                /* A rejected record is resent by the host: count it once, when it lands */
+                if (BL_OK == status)
+                {
+                    g_xfer.records++;
+                    g_xfer.bytes += record->data_len;
+                }
+                break;
+            }
 
-            if ((BL_OK == flush_st) && (0U != Bootloader_IsUserAppValid(APP_START_ADDR)))
+            case '5':
+            case '6':
             {
-                Bootloader_JumpToUserApp(APP_START_ADDR);
+                /* Address field holds the number of data records sent before it */
+                if (record->address != g_xfer.records)
+                {
+                    g_xfer.count_error = 1U;
+                    status             = BL_ERR_COUNT;
+                }
+                break;
+            }
+
+            case '7':
+            case '8':
+            case '9':
+            {
+                image_size = 0U;
+
+                if (BOOTLOADER_MODE_DELTA == g_record_mode)
+                {
+                    g_record_mode = BOOTLOADER_MODE_PLAIN;
+                    status        = BootDelta_End(&image_size);
+                    image_end     = BootSlot_GetBaseAddr(BootSlot_GetTarget()) + image_size;
+                }
+                else
+                {
+                    if (BOOTLOADER_MODE_LZ == g_record_mode)
+                    {
+                        g_record_mode = BOOTLOADER_MODE_PLAIN;
+                        status        = BootLz_End(&image_size);
+                    }
+
+                    if (BL_OK == status)
+                    {
+                        status = Bootloader_StreamEnd();
+                    }
+
+                    /* Sectors kept from a resumed download count towards the image */
+                    image_end = BootProgress_GetEndAddr();
+                    if (g_image_end > image_end)
+                    {
+                        image_end = g_image_end;
+                    }
+                }
+
+                if ((BL_OK == status) && (0U != g_xfer.count_error))
+                {
+                    /* Records were lost or duplicated: never switch to this image */
+                    status = BL_ERR_COUNT;
+                }
+
+                Bootloader_TransferSummary();
+
+                if (BL_OK == status)
+                {
+                    status = Bootloader_CommitImage(image_end);
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
             }
-            break;
         }
+    }
+
+    return status;
+}
 
-        default:
+/**
+ * @brief Check if a line holds a given bootloader command
+ *
+ * @param line Pointer to line (not NUL-terminated)
+ * @param len Line length
+ * @param cmd Command string
+ * @return uint8_t 1: match, 0: no match
+ */
+static uint8_t Bootloader_IsCommand(const uint8_t *line, uint32_t len, const char *cmd)
+{
+    uint8_t  match   = 0U;
+    uint32_t cmd_len = (uint32_t)strlen(cmd);
+
+    if ((len == cmd_len) && (0 == memcmp(line, cmd, cmd_len)))
+    {
+        match = 1U;
+    }
+
+    return match;
+}
+
+/**
+ * @brief Handle a bootloader command line ('#' prefix)
+ *
+ *   #PROGRESS : report ranges still missing in the target slot
+ *   #RESTART  : drop the resumable progress and start from scratch
+ *   #DELTA    : following data records carry a delta stream against the
+ *               active image (see BootDelta.h)
+ *   #LZ       : following data records carry an LZSS compressed image for
+ *               the target slot (see BootLz.h)
+ *   #BENCH    : run the micro-benchmarks (see BootBench.c)
+ *   #TRACE    : dump the event trace ring in binary (see Trace.h)
+ *   #FLASHSTATS : report flash command latencies and FSTAT errors
+ *
+ * @param line Pointer to command line (not NUL-terminated)
+ * @param len Line length
+ */
+void Bootloader_HandleCommand(const uint8_t *line, uint32_t len)
+{
+    if (NULL == line)
+    {
+        return;
+    }
+
+    if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_PROGRESS))
+    {
+        BootProgress_Report();
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_RESTART))
+    {
+        BootProgress_Discard();
+        g_cache_inited = 0U;
+        g_record_mode  = BOOTLOADER_MODE_PLAIN;
+        g_xfer.active  = 0U;
+        App_SendString("OK\r\n");
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_DELTA))
+    {
+        if (BOOTSLOT_NONE == BootSlot_GetActive())
         {
-            break;
+            /* Nothing to apply the delta to */
+            App_SendString("ERR\r\n");
         }
+        else
+        {
+            (void)BootDelta_Begin(BootSlot_GetBaseAddr(BootSlot_GetActive()),
+                                  BootSlot_GetBaseAddr(BootSlot_GetTarget()));
+            g_record_mode = BOOTLOADER_MODE_DELTA;
+            App_SendString("OK\r\n");
+        }
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_LZ))
+    {
+        /* Decompressed data goes through the phrase cache like plain records */
+        (void)BootLz_Begin(BootSlot_GetBaseAddr(BootSlot_GetTarget()), Bootloader_StreamWrite);
+        g_record_mode = BOOTLOADER_MODE_LZ;
+        App_SendString("OK\r\n");
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_BENCH))
+    {
+        BootBench_RunAll(App_SendString);
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_TRACE))
+    {
+        Trace_Dump();
+    }
+    else if (0U != Bootloader_IsCommand(line, len, BOOTLOADER_CMD_FLASHSTATS))
+    {
+        Bootloader_ReportFlashStats();
+    }
+    else
+    {
+        App_SendString("ERR\r\n");
     }
 }
@@ -0,0 +1,76 @@
+/**
+ * @file Crc32.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief CRC-32 (IEEE 802.3) implementation, nibble table driven
+ * @version 0.1
+ * @date 2026-02-02
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/Crc32.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* Reflected polynomial 0xEDB88320, one entry per 4-bit nibble (64 bytes) */
+static const uint32_t s_crc32_nibble_table[16U] =
+{
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief Feed data into a running CRC-32
+ *
+ * @param crc Running CRC value (start with CRC32_INIT_VALUE)
+ * @param data Pointer to data
+ * @param len Number of bytes
+ * @return uint32_t Updated running CRC value
+ */
+uint32_t Crc32_Update(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    if (NULL != data)
+    {
+        for (i = 0U; i < len; i++)
+        {
+            crc ^= (uint32_t)data[i];
+            crc  = (crc >> 4U) ^ s_crc32_nibble_table[crc & 0x0FU];
+            crc  = (crc >> 4U) ^ s_crc32_nibble_table[crc & 0x0FU];
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Finalize a running CRC-32
+ *
+ * @param crc Running CRC value
+ * @return uint32_t Final CRC-32
+ */
+uint32_t Crc32_Final(uint32_t crc)
+{
+    return (crc ^ 0xFFFFFFFFUL);
+}
+
+/**
+ * @brief Compute CRC-32 over one buffer
+ *
+ * @param data Pointer to data
+ * @param len Number of bytes
+ * @return uint32_t CRC-32
+ */
+uint32_t Crc32_Compute(const uint8_t *data, uint32_t len)
+{
+    return Crc32_Final(Crc32_Update(CRC32_INIT_VALUE, data, len));
+}
@@ -3,7 +3,12 @@
  ******************************************************************************/
 #include "incl/FLASH.h"
 
+#include <string.h>
 #include "S32K144.h"
+#include "system_S32K144.h"
+#include "incl/Bench.h"
+#include "DWT.h"
+#include "incl/Trace.h"
 extern const uint32_t Mem_43_INFLS_ACWriteRomStart;
 extern const uint32_t Mem_43_INFLS_ACWriteSize;
 typedef void (*Mem_43_INFLS_AcWritePtrType)  (void);
@@ -11,9 +16,148 @@ typedef void (*Mem_43_INFLS_AcWritePtrType)  (void);
 /* Macro for Access Code Call. On ARM/Thumb, BLX instruction used by the compiler for calling a function
 pointed to by the pointer requires that LSB bit of the address is set to one if the called fcn is coded in Thumb. */
 #define MEM_43_INFLS_AC_CALL(ptr2fcn, ptr2fcnType) ((ptr2fcnType)(((uint32_t)(ptr2fcn)) | MEM_43_INFLS_ARM_FAR_CALL2THUMB_CODE_BIT0_U32))
+/* FTFC command address of FlexNVM: bit 23 selects the D-Flash block */
+#define FTFC_D_FLASH_CMD_ADDR_BIT  (0x00800000UL)
+/* Address of a function of the access code section once copied to RAM */
+#define FLASH_AC_RAM_ADDRESS(fcn) ((uint32_t)WRITE_FUNCTION_ADDRESS + \
+                                   (((uint32_t)(fcn) & ~MEM_43_INFLS_ARM_FAR_CALL2THUMB_CODE_BIT0_U32) - \
+                                    (uint32_t)(&Mem_43_INFLS_ACWriteRomStart)))
+typedef uint8_t (*Flash_ProgramKernelPtrType)(const Flash_ProgramDesc_t *Desc, uint32_t Count,
+                                              Flash_CmdStats_t *Stats, uint32_t *Done);
+/* CCIF did not come back in time: reported in a reserved FSTAT bit, which the hardware reads as 0 */
+#define FLASH_FSTAT_TIMEOUT        (0x02U)
+/* Command failed: access error, protection violation, verify failure or timeout */
+#define FTFC_FSTAT_ERROR_MASK      (FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_FPVIOL_MASK | FTFC_FSTAT_MGSTAT0_MASK | \
+                                    FLASH_FSTAT_TIMEOUT)
+/* Upper bound of one command, above the slowest one (Erase Flash Block) */
+#define FLASH_CMD_TIMEOUT_MS       (5000U)
+/* Wait for CCIF, at most s_TimeoutCycles since Start: register and RAM reads
+ * only, so the access code can use it while the flash is busy */
+#define FLASH_WAIT_CCIF(Start)     while ((0U == (IP_FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK)) && \
+                                          ((MY_DWT->CYCCNT - (Start)) < s_TimeoutCycles)) {}
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t Flash_GetCommandAddress(uint32_t Addr);
+static uint8_t  Flash_LaunchCommand(uint8_t Kind);
+static uint8_t  Flash_WaitIdle(void);
+static uint8_t  Flash_Erase(uint32_t Addr, uint8_t Cmd, uint8_t Kind);
+static uint8_t  Flash_ProgramKernel(const Flash_ProgramDesc_t *Desc, uint32_t Count,
+                                    Flash_CmdStats_t *Stats, uint32_t *Done)
+                __attribute__ ((section (".acmem_43_infls_code_rom"), noinline, used));
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* Program/erase commands launched since reset */
+static uint32_t s_CommandCount = 0U;
+/* Latency histograms and FSTAT error counts since reset */
+static Flash_Stats_t s_Stats;
+/* FLASH_CMD_TIMEOUT_MS in core cycles, set by Mem_43_INFLS_IPW_LoadAc */
+static uint32_t s_TimeoutCycles = 0xFFFFFFFFUL;
 /*******************************************************************************
  * Codes
  ******************************************************************************/
+/* Translate a CPU (memory map) address to the FCCOB command address */
+static uint32_t Flash_GetCommandAddress(uint32_t Addr)
+{
+    uint32_t CmdAddr = Addr;
+
+    if ((Addr >= FTFC_D_FLASH_BASE) && (Addr < (FTFC_D_FLASH_BASE + FTFC_D_FLASH_SIZE)))
+    {
+        CmdAddr = (Addr - FTFC_D_FLASH_BASE) | FTFC_D_FLASH_CMD_ADDR_BIT;
+    }
+
+    return CmdAddr;
+}
+
+/* Launch the command loaded in FCCOB from RAM, time it and account its FSTAT.
+ * Returns FSTAT after completion. */
+static uint8_t Flash_LaunchCommand(uint8_t Kind)
+{
+    Flash_CmdStats_t *Cmd = &s_Stats.Cmd[Kind];
+    uint64_t          Start;
+    uint32_t          Cycles;
+    uint8_t           Fstat;
+
+    Start = Bench_GetCycles();
+
+    /* wait until operation finishes or write/erase timeout is reached */
+    MEM_43_INFLS_AC_CALL(FLASH_AC_RAM_ADDRESS(Ftfc_AccessCode), Mem_43_INFLS_AcWritePtrType)();
+
+    Cycles = (uint32_t)(Bench_GetCycles() - Start);
+    Fstat  = IP_FTFC->FSTAT;
+
+    if (0U == (Fstat & FTFC_FSTAT_CCIF_MASK))
+    {
+        /* Still running: give up on it, the next command waits for CCIF again */
+        Fstat |= FLASH_FSTAT_TIMEOUT;
+    }
+
+    if (0U == Cmd->Count)
+    {
+        Cmd->MinCycles = Cycles;
+    }
+    else if (Cycles < Cmd->MinCycles)
+    {
+        Cmd->MinCycles = Cycles;
+    }
+    else
+    {
+        /* not a new minimum */
+    }
+
+    if (Cycles > Cmd->MaxCycles)
+    {
+        Cmd->MaxCycles = Cycles;
+    }
+
+    Cmd->Count++;
+    Cmd->TotalCycles += Cycles;
+    /* Bin n holds latencies in [2^n, 2^(n+1)) cycles, 0 and 1 go to bin 0 */
+    Cmd->Hist[31U - (uint32_t)__builtin_clz(Cycles | 1U)]++;
+
+    if (0U != (Fstat & FTFC_FSTAT_ERROR_MASK))
+    {
+        Cmd->Errors++;
+    }
+    if (0U != (Fstat & FTFC_FSTAT_ACCERR_MASK))
+    {
+        s_Stats.AccErr++;
+    }
+    if (0U != (Fstat & FTFC_FSTAT_FPVIOL_MASK))
+    {
+        s_Stats.FpViol++;
+    }
+    if (0U != (Fstat & FTFC_FSTAT_MGSTAT0_MASK))
+    {
+        s_Stats.MgStat0++;
+    }
+    if (0U != (Fstat & FLASH_FSTAT_TIMEOUT))
+    {
+        s_Stats.Timeouts++;
+    }
+
+    return Fstat;
+}
+
+/* Wait until no command is running (CCIF set), at most FLASH_CMD_TIMEOUT_MS.
+ * Returns 1 when idle, 0 on timeout. */
+static uint8_t Flash_WaitIdle(void)
+{
+    uint32_t Start = MY_DWT->CYCCNT;
+    uint8_t  Idle  = 1U;
+
+    FLASH_WAIT_CCIF(Start);
+
+    if (0U == (IP_FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK))
+    {
+        s_Stats.Timeouts++;
+        Idle = 0U;
+    }
+
+    return Idle;
+}
+
 /* Get address*/
 uint32_t Read_FlashAddress(uint32_t Addr)
 {
@@ -22,10 +166,112 @@ uint32_t Read_FlashAddress(uint32_t Addr)
 
 void Ftfc_AccessCode(void)
 {
+    uint32_t Start = MY_DWT->CYCCNT;
+
     /* Clear CCIF */
     IP_FTFC->FSTAT = 0x80;
     /* wait until operation finishes or write/erase timeout is reached */
-    while (IP_FTFC->FSTAT == 0x00);
+    FLASH_WAIT_CCIF(Start);
+}
+
+/* Program every phrase of a descriptor list, running from RAM only: no call,
+ * no flash literal, so nothing is fetched from flash between two phrases.
+ * Per phrase latency goes to Stats like Flash_LaunchCommand does.
+ * Stops at the first phrase whose FSTAT reports an error and returns that
+ * FSTAT (0 when all done); Done receives the number of phrases programmed. */
+static uint8_t Flash_ProgramKernel(const Flash_ProgramDesc_t *Desc, uint32_t Count,
+                                   Flash_CmdStats_t *Stats, uint32_t *Done)
+{
+    uint32_t       i;
+    uint32_t       n;
+    uint32_t       Addr;
+    uint32_t       Start;
+    uint32_t       Cycles;
+    uint32_t       Total = 0U;
+    const uint8_t *Data;
+    uint8_t        Fstat = 0U;
+
+    for (i = 0U; (i < Count) && (0U == Fstat); i++)
+    {
+        Addr = Desc[i].Addr;
+        Data = Desc[i].Src;
+
+        if ((Addr >= FTFC_D_FLASH_BASE) && (Addr < (FTFC_D_FLASH_BASE + FTFC_D_FLASH_SIZE)))
+        {
+            Addr = (Addr - FTFC_D_FLASH_BASE) | FTFC_D_FLASH_CMD_ADDR_BIT;
+        }
+
+        for (n = 0U; (n < Desc[i].Phrases) && (0U == Fstat); n++)
+        {
+            /* wait previous cmd finish */
+            Start = MY_DWT->CYCCNT;
+            FLASH_WAIT_CCIF(Start);
+            if (0U == (IP_FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK))
+            {
+                Fstat = FLASH_FSTAT_TIMEOUT;
+                break;
+            }
+
+            /* clear previous cmd error */
+            if(IP_FTFC->FSTAT != 0x80)
+            {
+                IP_FTFC->FSTAT = 0x30;
+            }
+
+            IP_FTFC->FCCOB[3]  = CMD_PROGRAM_LONGWORD;
+            IP_FTFC->FCCOB[2]  = (uint8_t)(Addr >> 16);
+            IP_FTFC->FCCOB[1]  = (uint8_t)(Addr >> 8);
+            IP_FTFC->FCCOB[0]  = (uint8_t)(Addr >> 0);
+            IP_FTFC->FCCOB[7]  = Data[3];
+            IP_FTFC->FCCOB[6]  = Data[2];
+            IP_FTFC->FCCOB[5]  = Data[1];
+            IP_FTFC->FCCOB[4]  = Data[0];
+            IP_FTFC->FCCOB[11] = Data[7];
+            IP_FTFC->FCCOB[10] = Data[6];
+            IP_FTFC->FCCOB[9]  = Data[5];
+            IP_FTFC->FCCOB[8]  = Data[4];
+
+            Start = MY_DWT->CYCCNT;
+            IP_FTFC->FSTAT = 0x80;
+            FLASH_WAIT_CCIF(Start);
+            Cycles = MY_DWT->CYCCNT - Start;
+
+            if ((0U == Stats->Count) || (Cycles < Stats->MinCycles))
+            {
+                Stats->MinCycles = Cycles;
+            }
+            if (Cycles > Stats->MaxCycles)
+            {
+                Stats->MaxCycles = Cycles;
+            }
+            Stats->Count++;
+            Stats->TotalCycles += Cycles;
+            Stats->Hist[31U - (uint32_t)__builtin_clz(Cycles | 1U)]++;
+
+            Fstat = (uint8_t)(IP_FTFC->FSTAT & FTFC_FSTAT_ERROR_MASK);
+            if (0U == (IP_FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK))
+            {
+                Stats->Errors++;
+                Fstat = FLASH_FSTAT_TIMEOUT;
+            }
+            else if (0U != Fstat)
+            {
+                Stats->Errors++;
+                Fstat = IP_FTFC->FSTAT;
+            }
+            else
+            {
+                Total++;
+            }
+
+            Addr += FTFC_WRITE_DOUBLE_WORD;
+            Data += FTFC_WRITE_DOUBLE_WORD;
+        }
+    }
+
+    *Done = Total;
+
+    return Fstat;
 }
 
 void Mem_43_INFLS_IPW_LoadAc(void)
@@ -35,13 +281,24 @@ void Mem_43_INFLS_IPW_LoadAc(void)
     uint32_t       *RamPtr;
     const uint32_t *RomPtr;
 
+    /* Command timeout for the access code; also enables CYCCNT it counts with */
+    s_TimeoutCycles = (SystemCoreClock / 1000U) * FLASH_CMD_TIMEOUT_MS;
+    (void)Bench_GetCycles();
+
     /* MEM_43_INFLS_JOB_WRITE */
     RomPtr = (const uint32_t *)((uint32_t)(&Mem_43_INFLS_ACWriteRomStart));
     RamPtr = (uint32_t*)((uint32_t)(WRITE_FUNCTION_ADDRESS));
     AcSize = (uint32_t)(&Mem_43_INFLS_ACWriteSize);
 
-    /* Copy erase or write access code to RAM */
+    /* Copy erase or write access code to RAM: Ftfc_AccessCode and the batch
+     * program kernel, entered at their offset in the section */
     /* AcSize is dynamically calculated and might not be multiple of 4U */
+    if (AcSize > (FLASH_AC_RAM_SIZE / 4U))
+    {
+        /* Linker file out of sync with FLASH_AC_RAM_SIZE */
+        AcSize = FLASH_AC_RAM_SIZE / 4U;
+    }
+
     for (Count = 0U; Count < AcSize; Count++)
     {
         /* Copy 4 bytes at a time*/
@@ -51,8 +308,18 @@ void Mem_43_INFLS_IPW_LoadAc(void)
 /* Program Address and Data (8bit pointer) into Flash Memory */
 uint8_t Program_LongWord_8B(uint32_t Addr,uint8_t *Data)
 {
+    uint8_t Fstat;
+
+    Addr = Flash_GetCommandAddress(Addr);
+    s_CommandCount++;
+    TRACE_EVENT(TRACE_ID_PROGRAM_BEGIN, Addr);
+
     /* wait previous cmd finish */
-    while (IP_FTFC->FSTAT == 0x00);
+    if (0U == Flash_WaitIdle())
+    {
+        TRACE_EVENT(TRACE_ID_PROGRAM_END, FLASH_FSTAT_TIMEOUT);
+        return 0U;
+    }
 
     /* clear previous cmd error */
     if(IP_FTFC->FSTAT != 0x80)
@@ -80,47 +347,165 @@ uint8_t Program_LongWord_8B(uint32_t Addr,uint8_t *Data)
     IP_FTFC->FCCOB[9]  = (uint8_t)(Data[5]);
     IP_FTFC->FCCOB[8]  = (uint8_t)(Data[4]);
 
-    /* wait until operation finishes or write/erase timeout is reached */
-    MEM_43_INFLS_AC_CALL(WRITE_FUNCTION_ADDRESS, Mem_43_INFLS_AcWritePtrType)();
+    Fstat = Flash_LaunchCommand(FLASH_CMD_PROGRAM);
+    TRACE_EVENT(TRACE_ID_PROGRAM_END, Fstat);
 
-    return 1;
+    return (0U == (Fstat & FTFC_FSTAT_ERROR_MASK)) ? 1U : 0U;
 }
 
-/* Erase a flash Sector */
-uint8_t  Erase_Sector(uint32_t Addr)
+/* Launch an erase command (sector or block) for the CPU address Addr */
+static uint8_t Flash_Erase(uint32_t Addr, uint8_t Cmd, uint8_t Kind)
 {
+    uint8_t Fstat;
+
+    Addr = Flash_GetCommandAddress(Addr);
+    s_CommandCount++;
+    TRACE_EVENT(TRACE_ID_ERASE_BEGIN, Addr);
+
     /* wait previous cmd finish */
-    while (IP_FTFC->FSTAT == 0x00);
+    if (0U == Flash_WaitIdle())
+    {
+        TRACE_EVENT(TRACE_ID_ERASE_END, FLASH_FSTAT_TIMEOUT);
+        return 0U;
+    }
 
     /* clear previous cmd error */
     if(IP_FTFC->FSTAT != 0x80)
     {
         IP_FTFC->FSTAT = 0x30;
     }
-    /* Erase all bytes in a program flash sector */
-    IP_FTFC->FCCOB[3] = CMD_ERASE_FLASH_SECTOR;
+    /* Erase all bytes in a flash sector or block */
+    IP_FTFC->FCCOB[3] = Cmd;
 
     /* fill Address */
     IP_FTFC->FCCOB[2] = (uint8_t)(Addr >> 16);
     IP_FTFC->FCCOB[1] = (uint8_t)(Addr >> 8);
     IP_FTFC->FCCOB[0] = (uint8_t)(Addr >> 0);
 
-    /* wait until operation finishes or write/erase timeout is reached */
-    MEM_43_INFLS_AC_CALL(WRITE_FUNCTION_ADDRESS, Mem_43_INFLS_AcWritePtrType)();
-    return 1;
+    Fstat = Flash_LaunchCommand(Kind);
+    TRACE_EVENT(TRACE_ID_ERASE_END, Fstat);
+
+    return (0U == (Fstat & FTFC_FSTAT_ERROR_MASK)) ? 1U : 0U;
+}
+
+/* Program a list of phrase runs with one call of the RAM kernel */
+uint8_t  Flash_ProgramBatch(const Flash_ProgramDesc_t *Desc, uint32_t Count)
+{
+    uint32_t Done = 0U;
+    uint8_t  Fstat;
+
+    /* Enable CYCCNT (used by the kernel) and keep its 64-bit extension current */
+    (void)Bench_GetCycles();
+    TRACE_EVENT(TRACE_ID_PROGRAM_BEGIN, (0U != Count) ? Flash_GetCommandAddress(Desc[0].Addr) : 0U);
+
+    Fstat = MEM_43_INFLS_AC_CALL(FLASH_AC_RAM_ADDRESS(Flash_ProgramKernel), Flash_ProgramKernelPtrType)
+                (Desc, Count, &s_Stats.Cmd[FLASH_CMD_PROGRAM], &Done);
+
+    TRACE_EVENT(TRACE_ID_PROGRAM_END, Fstat);
+    (void)Bench_GetCycles();
+
+    /* The failing phrase was launched too */
+    s_CommandCount += Done + ((0U != Fstat) ? 1U : 0U);
+
+    if (0U != (Fstat & FTFC_FSTAT_ACCERR_MASK))
+    {
+        s_Stats.AccErr++;
+    }
+    if (0U != (Fstat & FTFC_FSTAT_FPVIOL_MASK))
+    {
+        s_Stats.FpViol++;
+    }
+    if (0U != (Fstat & FTFC_FSTAT_MGSTAT0_MASK))
+    {
+        s_Stats.MgStat0++;
+    }
+    if (0U != (Fstat & FLASH_FSTAT_TIMEOUT))
+    {
+        s_Stats.Timeouts++;
+    }
+
+    return (0U == Fstat) ? 1U : 0U;
+}
+
+/* Erase a flash Sector */
+uint8_t  Erase_Sector(uint32_t Addr)
+{
+    return Flash_Erase(Addr, CMD_ERASE_FLASH_SECTOR, FLASH_CMD_ERASE_SECTOR);
 }
 
 
 /* Erase all flash sector */
 uint8_t  Erase_Multi_Sector(uint32_t Addr,uint8_t Size)
 {
-    uint8_t i;
-    for(i = 0; i < Size; i++)
+    return Flash_EraseRange(Addr, Addr + ((uint32_t)Size * FTFC_P_FLASH_SECTOR_SIZE));
+}
+
+/* Erase [Start, End): whole blocks with one Erase Flash Block command each,
+ * the sectors before and after them one by one. Start and End must be
+ * sector aligned and lie in the same region (P-Flash or D-Flash). */
+uint8_t  Flash_EraseRange(uint32_t Start, uint32_t End)
+{
+    uint32_t RegionEnd;
+    uint32_t BlockSize;
+    uint32_t SectorSize;
+    uint32_t Addr;
+    uint8_t  Result = 1U;
+
+    if ((Start >= FTFC_D_FLASH_BASE) && (Start < (FTFC_D_FLASH_BASE + FTFC_D_FLASH_SIZE)))
+    {
+        RegionEnd  = FTFC_D_FLASH_BASE + FTFC_D_FLASH_SIZE;
+        BlockSize  = FTFC_D_FLASH_BLOCK_SIZE;
+        SectorSize = FTFC_D_FLASH_SECTOR_SIZE;
+    }
+    else
     {
-        Erase_Sector(Addr + i*FTFC_P_FLASH_SECTOR_SIZE);
+        RegionEnd  = FTFC_P_FLASH_SIZE;
+        BlockSize  = FTFC_P_FLASH_BLOCK_SIZE;
+        SectorSize = FTFC_P_FLASH_SECTOR_SIZE;
     }
-    return 1;
+
+    if ((End < Start) || (End > RegionEnd) ||
+        (0U != (Start % SectorSize)) || (0U != (End % SectorSize)))
+    {
+        Result = 0U;
+    }
+
+    Addr = Start;
+    while ((1U == Result) && (Addr < End))
+    {
+        /* Block erase only when the whole block is inside the range; blocks
+         * are aligned to their size in both regions */
+        if ((0U == (Addr % BlockSize)) && ((End - Addr) >= BlockSize))
+        {
+            Result = Flash_Erase(Addr, CMD_ERASE_FLASH_BLOCK, FLASH_CMD_ERASE_BLOCK);
+            Addr  += BlockSize;
+        }
+        else
+        {
+            Result = Flash_Erase(Addr, CMD_ERASE_FLASH_SECTOR, FLASH_CMD_ERASE_SECTOR);
+            Addr  += SectorSize;
+        }
+    }
+
+    return Result;
+}
+/* Number of program/erase commands launched since reset */
+uint32_t Flash_GetCommandCount(void)
+{
+    return s_CommandCount;
+}
+
+/* Latency histograms and error counts since reset (or Flash_ResetStats) */
+const Flash_Stats_t *Flash_GetStats(void)
+{
+    return &s_Stats;
 }
+
+void Flash_ResetStats(void)
+{
+    (void)memset(&s_Stats, 0, sizeof(s_Stats));
+}
+
 void FTFC_IRQHandler(void)
 {
 	/* */
@@ -14,13 +14,13 @@
 ==================================================================================================*/
 #include "incl/HAL_USART.h"
 #include "incl/NVIC.h"
+#include "incl/Trace.h"
 #include "S32K144.h"
 
 /*==================================================================================================
 * DEFINES
 ==================================================================================================*/
 #define CLEAR_LPUART_STAT    (0xFFFFFFFFUL)
-#define HAL_UART_RX_TIMEOUT_LOOP   (1000000U)
 #define LPUART1_IRQ_PRIORITY        (5U)  /* Priority level: 0..15 (implemented in MSBs) */
 
 /*==================================================================================================
@@ -47,6 +47,9 @@ void LPUART1_RxTx_IRQHandler(void)
 {
     uint32_t status = IP_LPUART1->STAT;
 
+    /* Status flags live in bits 14..31 */
+    TRACE_EVENT(TRACE_ID_UART_IRQ, status >> 8U);
+
     /* Handle Tx interrupt */
     if((status & LPUART_STAT_TDRE_MASK) && (IP_LPUART1->CTRL & LPUART_CTRL_TIE_MASK))
     {
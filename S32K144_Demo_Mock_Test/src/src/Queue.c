@@ -185,7 +185,8 @@ Queue_Status_t Queue_Srec_Push(Queue_Srec_t *queue, const uint8_t *line, uint32_
  * @param out_line Pointer to output buffer for SREC line
  * @param out_line_max Maximum length of output buffer
  * @param out_length Pointer to variable to receive actual length of popped line
- * @return Queue_Status_t Status of operation
+ * @return Queue_Status_t Status of operation, QUEUE_STATUS_TRUNCATED when only
+ *         out_line_max bytes of the line could be copied (the line is consumed)
  */
 Queue_Status_t Queue_Srec_Pop(Queue_Srec_t *queue, uint8_t *out_line, uint32_t out_line_max, uint32_t *out_length)
 {
@@ -227,7 +228,15 @@ Queue_Status_t Queue_Srec_Pop(Queue_Srec_t *queue, uint8_t *out_line, uint32_t o
             memcpy(out_line, queue->elements[queue->head].data, copy_len);
             *out_length = copy_len;
 
-            memset(queue->elements[queue->head].data, 0, QUEUE_MAX_LINE_LENGTH);
+            if (copy_len < queue->elements[queue->head].length)
+            {
+                status = QUEUE_STATUS_TRUNCATED;
+            }
+            else
+            {
+                status = QUEUE_STATUS_OK;
+            }
+
             queue->elements[queue->head].length = 0U;
 
             queue->head++;
@@ -240,10 +249,95 @@ Queue_Status_t Queue_Srec_Pop(Queue_Srec_t *queue, uint8_t *out_line, uint32_t o
             {
                 queue->count--;
             }
-
-            status = QUEUE_STATUS_OK;
         }
     }
 
     return status;
 }
+
+/**
+ * @brief Initialize line assembler
+ *
+ * @param line Pointer to line assembler instance
+ * @return Queue_Status_t Status of operation
+ */
+Queue_Status_t Queue_Line_Init(Queue_Line_t *line)
+{
+    Queue_Status_t status;
+
+    if (NULL == line)
+    {
+        status = QUEUE_STATUS_PARAM;
+    }
+    else
+    {
+        (void)memset(line, 0, sizeof(Queue_Line_t));
+        status = QUEUE_STATUS_OK;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Feed one received character to the line assembler
+ *
+ * CR or LF ends a line. A non-empty line is pushed to the queue; while the
+ * queue is full, drain is called to consume the oldest line. A line longer
+ * than QUEUE_LINE_BUFFER_SIZE - 1 is discarded up to its end, so its tail
+ * is never taken for a new line.
+ *
+ * @param line Pointer to line assembler instance
+ * @param queue Pointer to queue receiving complete lines
+ * @param c Received character
+ * @param drain Called to make room in a full queue
+ * @return Queue_LineEvent_t What the character completed
+ */
+Queue_LineEvent_t Queue_Line_PutChar(Queue_Line_t *line, Queue_Srec_t *queue, uint8_t c, Queue_Drain_t drain)
+{
+    Queue_LineEvent_t event = QUEUE_LINE_NONE;
+    Queue_Status_t    qst;
+
+    if ((NULL == line) || (NULL == queue) || (NULL == drain))
+    {
+        /* Nothing to assemble into */
+    }
+    else if ((c == (uint8_t)'\r') || (c == (uint8_t)'\n'))
+    {
+        if (0U != line->overflow)
+        {
+            /* Line did not fit the buffer: drop all of it */
+            line->overflow = 0U;
+            line->index    = 0U;
+            event          = QUEUE_LINE_DROPPED;
+        }
+        else if (line->index > 0U)
+        {
+            qst = Queue_Srec_Push(queue, line->buffer, line->index);
+
+            while (QUEUE_STATUS_FULL == qst)
+            {
+                (void)drain(queue);
+                qst = Queue_Srec_Push(queue, line->buffer, line->index);
+            }
+
+            line->index = 0U;
+            event       = QUEUE_LINE_PUSHED;
+        }
+        else
+        {
+            /* empty line -> ignore */
+        }
+    }
+    else if (line->index < (QUEUE_LINE_BUFFER_SIZE - 1U))
+    {
+        line->buffer[line->index] = c;
+        line->index++;
+    }
+    else
+    {
+        /* overflow: discard up to the end of the line */
+        line->overflow = 1U;
+    }
+
+    return event;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file Trace.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Timestamped event trace ring for the UART bootloader
+ * @version 0.1
+ * @date 2026-03-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "incl/Trace.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "incl/app.h"
+#include "incl/Bench.h"
+#include "DWT.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TRACE_RING_MASK            (TRACE_RING_SIZE - 1U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#if (0 != TRACE_ENABLE)
+static Trace_Event_t     s_ring[TRACE_RING_SIZE];
+static volatile uint32_t s_head    = 0U;      /* total events recorded */
+static volatile uint8_t  s_enabled = 0U;
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Clear the ring and start recording
+ *
+ * Enables the DWT cycle counter used for the timestamps.
+ */
+void Trace_Init(void)
+{
+#if (0 != TRACE_ENABLE)
+    s_enabled = 0U;
+
+    (void)Bench_GetCycles();
+    (void)memset(s_ring, 0, sizeof(s_ring));
+
+    s_head    = 0U;
+    s_enabled = 1U;
+#endif
+}
+
+/**
+ * @brief Record one event, callable from thread and interrupt context
+ *
+ * The slot is reserved with one atomic increment, so an interrupt that
+ * records in between gets its own slot and nothing is locked.
+ *
+ * @param id Event ID (TRACE_ID_*)
+ * @param arg Argument, low 24 bits kept
+ */
+void Trace_Record(uint8_t id, uint32_t arg)
+{
+#if (0 != TRACE_ENABLE)
+    uint32_t       idx;
+    Trace_Event_t *ev;
+
+    if (0U != s_enabled)
+    {
+        idx = __atomic_fetch_add(&s_head, 1U, __ATOMIC_RELAXED);
+        ev  = &s_ring[idx & TRACE_RING_MASK];
+
+        ev->timestamp = MY_DWT->CYCCNT;
+        ev->info      = ((uint32_t)id << TRACE_ID_SHIFT) | (arg & TRACE_ARG_MASK);
+    }
+#else
+    (void)id;
+    (void)arg;
+#endif
+}
+
+/**
+ * @brief Send the ring in binary (see Trace.h), oldest event first
+ *
+ * Recording is paused during the dump so the UART interrupts it causes do
+ * not overwrite the events being sent, then restarts from an empty ring.
+ */
+void Trace_Dump(void)
+{
+#if (0 != TRACE_ENABLE)
+    uint32_t head;
+    uint32_t count;
+    uint32_t first;
+    uint32_t part;
+
+    s_enabled = 0U;
+
+    head  = s_head;
+    count = (head < TRACE_RING_SIZE) ? head : TRACE_RING_SIZE;
+    first = (head - count) & TRACE_RING_MASK;
+    part  = TRACE_RING_SIZE - first;
+
+    if (part > count)
+    {
+        part = count;
+    }
+
+    App_SendString("TRACE ");
+    App_SendHex32(count);
+    App_SendString("\r\n");
+
+    /* Events are stored little-endian, the ring goes out as it is in RAM */
+    App_SendBytes((const uint8_t *)&s_ring[first], part * (uint32_t)sizeof(Trace_Event_t));
+    App_SendBytes((const uint8_t *)&s_ring[0], (count - part) * (uint32_t)sizeof(Trace_Event_t));
+
+    App_SendString("\r\nEND\r\n");
+
+    s_head    = 0U;
+    s_enabled = 1U;
+#else
+    App_SendString("TRACE ");
+    App_SendHex32(0U);
+    App_SendString("\r\n\r\nEND\r\n");
+#endif
+}
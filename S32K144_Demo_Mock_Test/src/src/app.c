@@ -37,11 +37,20 @@
 extern ARM_DRIVER_GPIO  Driver_GPIO0;
 extern ARM_DRIVER_USART Driver_USART0;
 
+/* Receive ring, filled from the USART callback (interrupt context) */
+#define APP_RX_RING_SIZE      (1024U)
+
 /*=============================================================================
  * FUNCTION PROTOTYPES
  =============================================================================*/
 volatile uint32_t usart_events = 0U;
 
+static volatile uint8_t  s_rxRing[APP_RX_RING_SIZE];
+static volatile uint32_t s_rxHead     = 0U;   /* written by interrupt only */
+static volatile uint32_t s_rxTail     = 0U;   /* written by main loop only */
+static volatile uint32_t s_rxOverflow = 0U;
+static uint8_t           s_rxByte;
+
 
 /*=============================================================================
  * FUNCTIONS
@@ -49,37 +58,121 @@ volatile uint32_t usart_events = 0U;
 
 void USART1_SignalEvent(uint32_t event)
 {
+    uint32_t next;
+
+    /* Re-arm reception right away, so bytes keep arriving while the main
+     * loop is busy programming flash or sending replies */
+    if (0U != (event & ARM_USART_EVENT_RECEIVE_COMPLETE))
+    {
+        next = (s_rxHead + 1U) % APP_RX_RING_SIZE;
+
+        if (next != s_rxTail)
+        {
+            s_rxRing[s_rxHead] = s_rxByte;
+            s_rxHead           = next;
+        }
+        else
+        {
+            s_rxOverflow++;
+        }
+
+        (void)Driver_USART0.Receive(&s_rxByte, 1U);
+    }
+
 	usart_events |= event;
 }
 
 /**
- * @brief Send a string via USART
+ * @brief Start interrupt driven reception into the receive ring
  *
- * @param str Null-terminated string to send
+ * @return int32_t ARM_DRIVER_OK on success, error code otherwise
  */
-void App_SendString(const char *str)
+int32_t App_StartReceive(void)
+{
+    s_rxHead = 0U;
+    s_rxTail = 0U;
+
+    return Driver_USART0.Receive(&s_rxByte, 1U);
+}
+
+/**
+ * @brief Take one received byte from the receive ring
+ *
+ * @param c Output byte
+ * @return uint8_t 1: byte returned, 0: ring empty
+ */
+uint8_t App_ReadByte(uint8_t *c)
+{
+    uint8_t result = 0U;
+
+    if (s_rxTail != s_rxHead)
+    {
+        *c       = s_rxRing[s_rxTail];
+        s_rxTail = (s_rxTail + 1U) % APP_RX_RING_SIZE;
+        result   = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Send raw bytes via USART (may contain NUL)
+ *
+ * @param data Bytes to send
+ * @param len Number of bytes
+ */
+void App_SendBytes(const uint8_t *data, uint32_t len)
 {
     ARM_DRIVER_USART *usart;
-    uint32_t          len;
     int32_t           status;
 
     usart  = &Driver_USART0;
-    len    = (uint32_t)strlen(str);
-    status = ARM_DRIVER_OK;
 
-        if (len > 0U)
+    /* Nothing sent means no SEND_COMPLETE event to wait for */
+    if ((NULL != data) && (len > 0U))
+    {
+        status = usart->Send(data, len);
+
+        while(0U == (usart_events & ARM_USART_EVENT_SEND_COMPLETE))
         {
-            status = usart->Send(str, len);
+            /* Wait until send is complete */
         }
 
-    while(0U == (usart_events & ARM_USART_EVENT_SEND_COMPLETE))
-    {
-        /* Wait until send is complete */
+        usart_events &= ~ARM_USART_EVENT_SEND_COMPLETE;
+        (void)status;
     }
+}
 
-    usart_events &= ~ARM_USART_EVENT_SEND_COMPLETE;
-    (void)status;
+/**
+ * @brief Send a string via USART
+ *
+ * @param str Null-terminated string to send
+ */
+void App_SendString(const char *str)
+{
+    App_SendBytes((const uint8_t *)str, (uint32_t)strlen(str));
 }
 
+/**
+ * @brief Send a 32-bit value as "0xXXXXXXXX" via USART
+ *
+ * @param value Value to send
+ */
+void App_SendHex32(uint32_t value)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char              buf[11];
+    uint32_t          i;
+
+    buf[0] = '0';
+    buf[1] = 'x';
+
+    for (i = 0U; i < 8U; i++)
+    {
+        buf[2U + i] = hex[(value >> (28U - (4U * i))) & 0x0FU];
+    }
 
+    buf[10] = '\0';
 
+    App_SendString(buf);
+}
@@ -34,17 +34,53 @@
 * INCLUDES
 ==================================================================================================*/
 #include "incl/clocks_and_modes.h"
+#include "TimeBase.h"
+#include "system_S32K144.h"
 
 #include "device_registers.h"	/* include peripheral declarations S32K144 */
 
+/*==================================================================================================
+* DEFINES
+==================================================================================================*/
+/* Upper bounds of the clock waits: crystal start-up and PLL lock take a few ms */
+#define CLOCK_SOSC_TIMEOUT_MS    (50U)
+#define CLOCK_SPLL_TIMEOUT_MS    (10U)
+#define CLOCK_SWITCH_TIMEOUT_MS  (10U)
+
 /*==================================================================================================
 * FUNCTIONS
 ==================================================================================================*/
+/**
+ * @brief Wait until (*reg & mask) == value, at most timeout_ms.
+ *
+ * @param reg Register to poll
+ * @param mask Bits to compare
+ * @param value Expected value of the bits
+ * @param timeout_ms Timeout in ms
+ * @return uint8_t 1: condition met, 0: timeout
+ */
+static uint8_t Clock_WaitFor(const volatile uint32_t *reg, uint32_t mask, uint32_t value, uint32_t timeout_ms)
+{
+	Time_Deadline_t deadline = Time_Deadline(timeout_ms);
+
+	while ((*reg & mask) != value)
+	{
+		if (0U != Time_Expired(deadline))
+		{
+			/* Check once more: the wait may have been preempted past the deadline */
+			return ((*reg & mask) == value) ? 1U : 0U;
+		}
+	}
+
+	return 1U;
+}
+
 /**
  * @brief Initialize System Oscillator (SOSC) for 8 MHz external crystal.
  *
+ * @return uint8_t 1: SOSC valid, 0: timeout (no crystal)
  */
-void SOSC_init_8MHz(void)
+uint8_t SOSC_init_8MHz(void)
 {
 	/*!
 	 * SOSC Initialization (8 MHz):
@@ -56,7 +92,10 @@ void SOSC_init_8MHz(void)
 					SCG_SOSCCFG_EREFS_MASK;		/* HGO=0:   Config xtal osc for low power 		*/
   	  	  	  	  	  	  	  	  	  	  	  	/* EREFS=1: Input is external XTAL 			*/
 
-  while(IP_SCG->SOSCCSR & SCG_SOSCCSR_LK_MASK); 	/* Ensure SOSCCSR unlocked 							*/
+  if (0U == Clock_WaitFor(&IP_SCG->SOSCCSR, SCG_SOSCCSR_LK_MASK, 0U, CLOCK_SOSC_TIMEOUT_MS))
+  {
+    return 0U;                                  	/* SOSCCSR stays locked 							*/
+  }
   IP_SCG->SOSCCSR = SCG_SOSCCSR_SOSCEN_MASK; 		/* LK=0:          SOSCCSR can be written 				*/
 												/* SOSCCMRE=0:    OSC CLK monitor IRQ if enabled 		*/
 												/* SOSCCM=0:      OSC CLK monitor disabled 			*/
@@ -65,20 +104,25 @@ void SOSC_init_8MHz(void)
 												/* SOSCSTEN=0:    Sys OSC disabled in Stop modes 		*/
 												/* SOSCEN=1:      Enable oscillator 					*/
 
-while(!(IP_SCG->SOSCCSR & SCG_SOSCCSR_SOSCVLD_MASK));	/* Wait for sys OSC clk valid */
+  /* Wait for sys OSC clk valid: no crystal or a bad one times out */
+  return Clock_WaitFor(&IP_SCG->SOSCCSR, SCG_SOSCCSR_SOSCVLD_MASK, SCG_SOSCCSR_SOSCVLD_MASK, CLOCK_SOSC_TIMEOUT_MS);
 }
 
 /**
  * @brief Initialize System PLL (SPLL) for 160 MHz system clock.
  *
+ * @return uint8_t 1: SPLL locked, 0: timeout
  */
-void SPLL_init_160MHz(void)
+uint8_t SPLL_init_160MHz(void)
 {
 	/*!
 	 * SPLL Initialization (160 MHz):
 	 * ===================================================
 	 */
-  while(IP_SCG->SPLLCSR & SCG_SPLLCSR_LK_MASK); 	/* Ensure SPLLCSR unlocked 				*/
+  if (0U == Clock_WaitFor(&IP_SCG->SPLLCSR, SCG_SPLLCSR_LK_MASK, 0U, CLOCK_SPLL_TIMEOUT_MS))
+  {
+    return 0U;                                  	/* SPLLCSR stays locked 				*/
+  }
   IP_SCG->SPLLCSR &= ~SCG_SPLLCSR_SPLLEN_MASK;  	/* SPLLEN=0: SPLL is disabled (default) 	*/
 
   IP_SCG->SPLLDIV |= 	SCG_SPLLDIV_SPLLDIV1(2)|	/* SPLLDIV1 divide by 2 */
@@ -88,22 +132,29 @@ void SPLL_init_160MHz(void)
   	  	  	  	  	  	  	  	  	  	  		/* MULT=24:  Multiply sys pll by 4+24=40 	*/
 										  		/* SPLL_CLK = 8MHz / 1 * 40 / 2 = 160 MHz 	*/
 
-  while(IP_SCG->SPLLCSR & SCG_SPLLCSR_LK_MASK); 	/* Ensure SPLLCSR unlocked 						*/
+  if (0U == Clock_WaitFor(&IP_SCG->SPLLCSR, SCG_SPLLCSR_LK_MASK, 0U, CLOCK_SPLL_TIMEOUT_MS))
+  {
+    return 0U;                                  	/* SPLLCSR stays locked 						*/
+  }
   IP_SCG->SPLLCSR |= SCG_SPLLCSR_SPLLEN_MASK; 		/* LK=0:        SPLLCSR can be written 			*/
                              	 	 	 		/* SPLLCMRE=0:  SPLL CLK monitor IRQ if enabled 	*/
                              	 	 	 	 	/* SPLLCM=0:    SPLL CLK monitor disabled 			*/
                              	 	 	 	 	/* SPLLSTEN=0:  SPLL disabled in Stop modes 		*/
                              	 	 	 	 	/* SPLLEN=1:    Enable SPLL 						*/
 
-  while(!(IP_SCG->SPLLCSR & SCG_SPLLCSR_SPLLVLD_MASK)); /* Wait for SPLL valid */
+  /* Wait for SPLL valid */
+  return Clock_WaitFor(&IP_SCG->SPLLCSR, SCG_SPLLCSR_SPLLVLD_MASK, SCG_SPLLCSR_SPLLVLD_MASK, CLOCK_SPLL_TIMEOUT_MS);
 }
 
 /**
  * @brief Switch to Normal RUN mode with 80 MHz core clock using SPLL.
  *
+ * @return uint8_t 1: running from SPLL, 0: timeout (clock not switched)
  */
-void NormalRUNmode_80MHz (void)
+uint8_t NormalRUNmode_80MHz (void)
 {
+	uint8_t result;
+
 /*! Slow IRC is enabled with high range (8 MHz) in reset.
  *	Enable SIRCDIV2_CLK and SIRCDIV1_CLK, divide by 1 = 8MHz
  *  asynchronous clock source.
@@ -121,5 +172,11 @@ void NormalRUNmode_80MHz (void)
     |SCG_RCCR_DIVBUS(0b01)       /* DIVBUS=1, div. by 2: bus clock = 40 MHz 					*/
     |SCG_RCCR_DIVSLOW(0b10);     /* DIVSLOW=2, div. by 2: SCG slow, flash clock= 26 2/3 MHz	*/
 
-  while (((IP_SCG->CSR & SCG_CSR_SCS_MASK) >> SCG_CSR_SCS_SHIFT ) != 6) {}	/* Wait for sys clk src = SPLL */
+  result = Clock_WaitFor(&IP_SCG->CSR, SCG_CSR_SCS_MASK, SCG_CSR_SCS(6), CLOCK_SWITCH_TIMEOUT_MS);	/* Wait for sys clk src = SPLL */
+
+  /* Core clock changed: refresh SystemCoreClock and rescale the time base */
+  SystemCoreClockUpdate();
+  Time_Init();
+
+  return result;
 }
@@ -0,0 +1,178 @@
+/**
+ * @file ihex.c
+ * @author Dung (dungpv00@gmail.com)
+ * @brief Intel HEX parsing implementation
+ * @version 0.1
+ * @date 2026-03-01
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+/*============================================================================
+ * INCLUDE
+ =============================================================================*/
+#include "incl/ihex.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include "incl/Trace.h"
+
+/*============================================================================
+ * DEFINES
+ =============================================================================*/
+#define IHEX_HEADER_BYTES      (4U)    /* count, address (2), type */
+#define IHEX_MIN_LINE_LEN      (1U + (2U * (IHEX_HEADER_BYTES + 1U)))
+
+/*============================================================================
+ * API FUNCTIONS
+ =============================================================================*/
+/**
+ * @brief Reset the Intel HEX context (start of a new file)
+ *
+ * @param ctx Pointer to context
+ */
+void Ihex_Init(ihex_context_t *ctx)
+{
+    if (ctx != NULL)
+    {
+        ctx->base  = 0U;
+        ctx->entry = 0U;
+    }
+}
+
+/**
+ * @brief Parse one Intel HEX line, decoding the hex pairs in place
+ *
+ * Byte k of the record (count, address, type, data, checksum) is written to
+ * cmd_buffer[k]; it is read from cmd_buffer[1 + 2k], so decoding never
+ * overwrites characters still to be read. On success view->data points
+ * into cmd_buffer.
+ *
+ * @param ctx Pointer to context of the file being parsed
+ * @param cmd_buffer Pointer to line (NUL, CR or LF terminated, modified)
+ * @param max_len Number of valid characters in cmd_buffer
+ * @param view Pointer to output record view
+ * @return Srec_Status_t Status of parsing
+ */
+Srec_Status_t Ihex_ParseLine(ihex_context_t *ctx, uint8_t *cmd_buffer, uint32_t max_len, srec_view_t *view)
+{
+    Srec_Status_t status = SREC_STATUS_PARAM;
+    uint8_t       sum    = 0U;
+    uint32_t      line_len;
+    uint32_t      count  = 0U;
+    uint32_t      offset;
+    uint32_t      value  = 0U;
+    uint32_t      i;
+
+    TRACE_EVENT(TRACE_ID_PARSE_BEGIN, max_len);
+
+    if ((NULL == ctx) || (NULL == cmd_buffer) || (NULL == view))
+    {
+        /* PARAM */
+    }
+    else
+    {
+        view->type     = IHEX_RECORD_NONE;
+        view->address  = 0U;
+        view->data     = NULL;
+        view->data_len = 0U;
+
+        line_len = Srec_LineLenBounded(cmd_buffer, max_len);
+        status   = SREC_STATUS_FORMAT;
+
+        if ((line_len >= IHEX_MIN_LINE_LEN) && (IHEX_START_CODE == cmd_buffer[0]))
+        {
+            status = Srec_HexToByte(cmd_buffer[1], cmd_buffer[2], &cmd_buffer[0]);
+        }
+
+        if (SREC_STATUS_OK == status)
+        {
+            count = cmd_buffer[0];
+
+            if (line_len < (IHEX_MIN_LINE_LEN + (2U * count)))
+            {
+                status = SREC_STATUS_FORMAT;
+            }
+        }
+
+        /* Decode address, type, data and checksum */
+        for (i = 0U; (SREC_STATUS_OK == status) && (i < (IHEX_HEADER_BYTES + count + 1U)); i++)
+        {
+            if (0U != i)
+            {
+                status = Srec_HexToByte(cmd_buffer[1U + (2U * i)], cmd_buffer[2U + (2U * i)], &cmd_buffer[i]);
+            }
+            sum = (uint8_t)(sum + cmd_buffer[i]);
+        }
+
+        /* checksum: two's complement, all bytes sum to 0 */
+        if ((SREC_STATUS_OK == status) && (0U != sum))
+        {
+            status = SREC_STATUS_CHECKSUM;
+        }
+
+        if (SREC_STATUS_OK == status)
+        {
+            offset = ((uint32_t)cmd_buffer[1] << 8U) | (uint32_t)cmd_buffer[2];
+
+            /* Big-endian argument of the address/start records */
+            for (i = 0U; (IHEX_TYPE_DATA != cmd_buffer[3]) && (i < count) && (i < 4U); i++)
+            {
+                value = (value << 8U) | (uint32_t)cmd_buffer[IHEX_HEADER_BYTES + i];
+            }
+
+            switch (cmd_buffer[3])
+            {
+                case IHEX_TYPE_DATA:
+                    view->type     = (uint8_t)'3';
+                    view->address  = ctx->base + offset;
+                    view->data     = &cmd_buffer[IHEX_HEADER_BYTES];
+                    view->data_len = count;
+                    break;
+
+                case IHEX_TYPE_EOF:
+                    view->type     = (uint8_t)'7';
+                    view->address  = ctx->entry;
+                    break;
+
+                case IHEX_TYPE_EXT_SEGMENT:
+                    ctx->base = value << 4U;
+                    status    = (2U == count) ? SREC_STATUS_OK : SREC_STATUS_FORMAT;
+                    break;
+
+                case IHEX_TYPE_EXT_LINEAR:
+                    ctx->base = value << 16U;
+                    status    = (2U == count) ? SREC_STATUS_OK : SREC_STATUS_FORMAT;
+                    break;
+
+                case IHEX_TYPE_START_SEG:
+                    /* CS:IP */
+                    ctx->entry = ((value >> 16U) << 4U) + (value & 0xFFFFU);
+                    status     = (4U == count) ? SREC_STATUS_OK : SREC_STATUS_FORMAT;
+                    break;
+
+                case IHEX_TYPE_START_LINEAR:
+                    ctx->entry = value;
+                    status     = (4U == count) ? SREC_STATUS_OK : SREC_STATUS_FORMAT;
+                    break;
+
+                default:
+                    status = SREC_STATUS_FORMAT;
+                    break;
+            }
+        }
+    }
+
+    /* If invalid, clear output */
+    if ((SREC_STATUS_OK != status) && (view != NULL))
+    {
+        view->type     = IHEX_RECORD_NONE;
+        view->address  = 0U;
+        view->data     = NULL;
+        view->data_len = 0U;
+    }
+
+    TRACE_EVENT(TRACE_ID_PARSE_END, status);
+
+    return status;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file Bench.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Micro-benchmark harness: DWT cycle counter on target, clock_gettime on host
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Build with BENCH_HOST defined to use the host backend (nanoseconds from
+ * clock_gettime) instead of the Cortex-M4 DWT cycle counter.
+ *
+ * Report, one line per benchmark:
+ *   BENCH,<name>,<unit>,<reps>,<min>,<median>,<max>
+ * unit is "cyc" on target and "ns" on host.
+ */
+#define BENCH_MAX_REPS             (64U)
+
+#if defined(BENCH_HOST)
+#define BENCH_UNIT                 "ns"
+#else
+#define BENCH_UNIT                 "cyc"
+#endif
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Benchmark step, ctx is the case context
+ */
+typedef void (*Bench_Fn_t)(void *ctx);
+
+/**
+ * @brief Text output (one NUL-terminated string per call)
+ */
+typedef void (*Bench_Print_t)(const char *str);
+
+/**
+ * @brief One registered micro-benchmark
+ */
+typedef struct
+{
+    const char *name;
+    Bench_Fn_t  setup;       /* optional, run before every repetition, not timed */
+    Bench_Fn_t  run;         /* timed */
+    void       *ctx;
+} Bench_Case_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+uint64_t Bench_GetCycles(void);
+void     Bench_Run(const Bench_Case_t *cases, uint32_t count, uint32_t warmup, uint32_t reps,
+                   Bench_Print_t print);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,37 @@
+/**
+ * @file BootBench.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Micro-benchmarks of the bootloader hot paths
+ * @version 0.1
+ * @date 2026-03-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTBENCH_H_
+#define BOOTBENCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "Bench.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BOOTBENCH_WARMUP           (4U)
+#define BOOTBENCH_REPS             (32U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void BootBench_RunAll(Bench_Print_t print);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTBENCH_H_ */
@@ -0,0 +1,60 @@
+/**
+ * @file BootDelta.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Differential (delta) image update for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-23
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTDELTA_H_
+#define BOOTDELTA_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Delta stream, sent after "#DELTA" as ordinary S1/S2/S3 records whose
+ * address field is the byte offset in the delta stream (must be contiguous).
+ * The terminator record (S7/S8/S9) ends the stream.
+ *
+ * The new image is rebuilt from offset 0 of the target slot, reading the old
+ * image from the active slot. Ops (little-endian arguments):
+ *   0x01 COPY    u32 old_offset, u16 len : copy len bytes from old[old_offset]
+ *   0x02 LITERAL u16 len, len bytes      : take len bytes from the stream
+ *   0x03 SKIP    u16 len                 : copy len bytes from old[same offset]
+ *
+ * Output is assembled one sector at a time in RAM; a target sector that
+ * already holds the same content is neither erased nor programmed.
+ *
+ * Limitation: with A/B slots the target slot holds the image from before the
+ * active one, so the skip above compares against that older image. A sector
+ * unchanged since the running image is still erased and programmed when it
+ * differs from the older one. The stream size follows the last change, the
+ * erase count and flash time follow the change over two updates.
+ * "bltool delta" reports both sector counts.
+ */
+#define BOOTDELTA_OP_COPY          (0x01U)
+#define BOOTDELTA_OP_LITERAL       (0x02U)
+#define BOOTDELTA_OP_SKIP          (0x03U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+int32_t BootDelta_Begin(uint32_t old_base, uint32_t new_base);
+int32_t BootDelta_Write(uint32_t stream_offset, const uint8_t *data, uint32_t len);
+int32_t BootDelta_End(uint32_t *image_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTDELTA_H_ */
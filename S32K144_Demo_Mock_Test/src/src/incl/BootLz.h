@@ -0,0 +1,61 @@
+/**
+ * @file BootLz.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Streaming LZSS decompression for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTLZ_H_
+#define BOOTLZ_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Compressed stream, sent after "#LZ" as ordinary S1/S2/S3 records whose
+ * address field is the byte offset in the compressed stream (must be
+ * contiguous). The terminator record (S7/S8/S9) ends the stream.
+ *
+ * The stream is a sequence of groups: one flag byte followed by up to 8
+ * items, flag bit 0 first. A set bit is a literal byte, a clear bit is a
+ * 2-byte little-endian match token:
+ *   bits  0..9  : distance - 1 (1..1024 bytes back in the output)
+ *   bits 10..15 : length - 3   (3..66 bytes)
+ *
+ * Output is written from offset 0 of the given base address.
+ */
+#define BOOTLZ_WINDOW_SIZE          (1024U)
+#define BOOTLZ_DIST_BITS            (10U)
+#define BOOTLZ_MIN_MATCH            (3U)
+#define BOOTLZ_MAX_MATCH            (BOOTLZ_MIN_MATCH + 63U)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Sink for decompressed data (one contiguous address range per call)
+ */
+typedef int32_t (*BootLz_Output_t)(uint32_t address, const uint8_t *data, uint32_t len);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+int32_t BootLz_Begin(uint32_t base, BootLz_Output_t output);
+int32_t BootLz_Write(uint32_t stream_offset, const uint8_t *data, uint32_t len);
+int32_t BootLz_End(uint32_t *image_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTLZ_H_ */
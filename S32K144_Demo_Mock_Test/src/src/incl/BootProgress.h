@@ -0,0 +1,55 @@
+/**
+ * @file BootProgress.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Persistent per-sector download progress for resumable transfers
+ * @version 0.1
+ * @date 2026-02-09
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTPROGRESS_H_
+#define BOOTPROGRESS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "BootSlot.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Progress log, one FlexNVM (D-Flash) sector after the two slot records:
+ *   offset 0x00 : header  { magic, slot, base sequence, header CRC }
+ *   offset 0x10 : entry[sector] { tag | sector, CRC-32 of sector }  (8 bytes)
+ *
+ * Every slot sector owns a fixed entry, programmed once when the sector has
+ * been programmed and read back. The header binds the log to the target slot
+ * and to the active image it was started against.
+ */
+#define BOOTPROGRESS_BASE_ADDR     (BOOTSLOT_META_BASE_ADDR + (BOOTSLOT_COUNT * BOOTSLOT_META_SECTOR_SIZE))
+#define BOOTPROGRESS_HEADER_MAGIC  (0x50524F47UL) /* "PROG" */
+#define BOOTPROGRESS_ENTRY_TAG     (0x5EC70000UL)
+#define BOOTPROGRESS_BITMAP_WORDS  ((BOOTSLOT_SECTOR_COUNT + 31U) / 32U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+uint8_t  BootProgress_Open(uint8_t slot, uint32_t base_sequence);
+void     BootProgress_Discard(void);
+void     BootProgress_Close(void);
+uint8_t  BootProgress_IsDone(uint32_t sector);
+void     BootProgress_MarkDone(uint32_t sector);
+uint32_t BootProgress_GetDoneCount(void);
+uint32_t BootProgress_GetEndAddr(void);
+void     BootProgress_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTPROGRESS_H_ */
@@ -0,0 +1,67 @@
+/**
+ * @file BootProto.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Windowed ACK/NAK transfer protocol for the UART bootloader
+ * @version 0.1
+ * @date 2026-02-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTPROTO_H_
+#define BOOTPROTO_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "Queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Frame (one line):   '@' SS <payload> CC
+ *   SS      : sequence number, 2 hex digits, modulo 256
+ *   payload : one SREC line or '#' command
+ *   CC      : 2 hex digits, ~(SS + sum of payload characters) & 0xFF
+ *
+ * Replies (one line each):
+ *   "Ass" : frame ss received intact
+ *   "Nss" : frame ss missing or damaged, retransmit it
+ *   "Ess" : frame ss was rejected by the bootloader, abort the transfer
+ *
+ * The host may keep up to BOOTPROTO_WINDOW_SIZE frames unacknowledged and
+ * retransmits NAKed frames (or unacknowledged ones after a timeout) only.
+ * Frames received ahead of a gap are buffered and handled in sequence order,
+ * so records always reach the phrase cache in the order they were sent.
+ */
+#define BOOTPROTO_WINDOW_SIZE      (QUEUE_MAX_ELEMENTS)
+#define BOOTPROTO_FRAME_START      ((uint8_t)'@')
+#define BOOTPROTO_MAX_PAYLOAD      (QUEUE_MAX_LINE_LENGTH)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Payload consumer, called in sequence order
+ *
+ * @param payload NUL-terminated payload; the consumer may decode it in place
+ * @param len Payload length
+ * @return int32_t BL_OK or bl_status_t error
+ */
+typedef int32_t (*BootProto_Deliver_t)(uint8_t *payload, uint32_t len);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void BootProto_Init(BootProto_Deliver_t deliver);
+void BootProto_HandleFrame(const uint8_t *frame, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTPROTO_H_ */
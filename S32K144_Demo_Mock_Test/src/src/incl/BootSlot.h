@@ -0,0 +1,86 @@
+/**
+ * @file BootSlot.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief A/B application slot management for the S32K144 bootloader
+ * @version 0.1
+ * @date 2026-02-02
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOTSLOT_H_
+#define BOOTSLOT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * P-Flash layout (512 KB):
+ *   0x00000000 - 0x00009FFF : bootloader
+ *   0x0000A000 - 0x00044FFF : slot A (59 sectors)
+ *   0x00045000 - 0x0007FFFF : slot B (59 sectors)
+ *
+ * Each slot has one status record in its own FlexNVM (D-Flash) sector, so
+ * invalidating one slot never touches the record of the other one.
+ * Images must be linked for the slot they are downloaded to.
+ */
+#define BOOTSLOT_COUNT             (2U)
+#define BOOTSLOT_A                 (0U)
+#define BOOTSLOT_B                 (1U)
+#define BOOTSLOT_NONE              (0xFFU)
+
+#define BOOTSLOT_A_BASE_ADDR       (0x0000A000UL)
+#define BOOTSLOT_SIZE              (0x0003B000UL)
+#define BOOTSLOT_B_BASE_ADDR       (BOOTSLOT_A_BASE_ADDR + BOOTSLOT_SIZE)
+#define BOOTSLOT_SECTOR_SIZE       (0x1000UL)
+#define BOOTSLOT_SECTOR_COUNT      (BOOTSLOT_SIZE / BOOTSLOT_SECTOR_SIZE)
+
+#define BOOTSLOT_META_BASE_ADDR    (0x10000000UL) /* FlexNVM D-Flash */
+#define BOOTSLOT_META_SECTOR_SIZE  (0x800UL)
+
+#define BOOTSLOT_RECORD_MAGIC      (0x534C4F54UL) /* "SLOT" */
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief Slot status record, stored at the start of the slot's D-Flash sector
+ *
+ * Size is a multiple of the 8-byte program phrase. record_crc covers all
+ * previous fields, so a record torn by a reset is simply seen as invalid.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t slot;
+    uint32_t sequence;      /* higher sequence = newer image */
+    uint32_t image_size;    /* bytes from slot base */
+    uint32_t image_crc;     /* CRC-32 of [base, base + image_size) */
+    uint32_t reserved[2U];
+    uint32_t record_crc;
+} BootSlot_Record_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void     BootSlot_Init(void);
+uint8_t  BootSlot_GetActive(void);
+uint8_t  BootSlot_GetTarget(void);
+uint32_t BootSlot_GetActiveSequence(void);
+uint32_t BootSlot_GetBaseAddr(uint8_t slot);
+uint32_t BootSlot_GetEndAddrExcl(uint8_t slot);
+int32_t  BootSlot_BeginDownload(void);
+int32_t  BootSlot_Commit(uint32_t image_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTSLOT_H_ */
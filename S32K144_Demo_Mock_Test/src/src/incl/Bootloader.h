@@ -29,7 +29,10 @@ typedef enum
     BL_ERR_PARAM = -1,
     BL_ERR_RANGE = -2,
     BL_ERR_FLASH = -3,
-    BL_ERR_VERIFY = -4
+    BL_ERR_VERIFY = -4,
+    BL_ERR_FORMAT = -5,
+    BL_ERR_CHECKSUM = -6,
+    BL_ERR_COUNT = -7
 } bl_status_t;
 
 /*******************************************************************************
@@ -38,7 +41,8 @@ typedef enum
 uint8_t Bootloader_IsUserAppValid(uint32_t app_base_addr);
 void Bootloader_JumpToUserApp(uint32_t app_base_addr);
 typedef void (*JumpToPtr)(void);
-void Bootloader_HandleRecord(const srec_record_t *record, uint32_t *entry_point);
+int32_t Bootloader_HandleRecord(const srec_view_t *record, uint32_t *entry_point);
+void Bootloader_HandleCommand(const uint8_t *line, uint32_t len);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,37 @@
+/**
+ * @file Crc32.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief CRC-32 (IEEE 802.3) helper for bootloader image and metadata checks
+ * @version 0.1
+ * @date 2026-02-02
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CRC32_INIT_VALUE           (0xFFFFFFFFUL)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+uint32_t Crc32_Update(uint32_t crc, const uint8_t *data, uint32_t len);
+uint32_t Crc32_Final(uint32_t crc);
+uint32_t Crc32_Compute(const uint8_t *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_H_ */
@@ -11,16 +11,82 @@
  * Defines
  ******************************************************************************/
 #define CMD_PROGRAM_LONGWORD     (0x07)
+#define CMD_ERASE_FLASH_BLOCK    (0x08)
 #define CMD_ERASE_FLASH_SECTOR   (0x09)
 /**
  * @brief  Program alignment
  */
 #define FTFC_WRITE_DOUBLE_WORD   (8U)
 #define FTFC_P_FLASH_SECTOR_SIZE (0x1000)
+/**
+ * @brief  P-Flash size; S32K144 has a single 512 KB P-Flash block
+ */
+#define FTFC_P_FLASH_SIZE        (0x80000UL)
+#define FTFC_P_FLASH_BLOCK_SIZE  (0x80000UL)
+/**
+ * @brief  FlexNVM (D-Flash) memory map, used for bootloader metadata
+ */
+#define FTFC_D_FLASH_BASE        (0x10000000UL)
+#define FTFC_D_FLASH_SIZE        (0x10000UL)
+#define FTFC_D_FLASH_SECTOR_SIZE (0x800)
+#define FTFC_D_FLASH_BLOCK_SIZE  (0x10000UL)
 #define WRITE_FUNCTION_ADDRESS    (0x1FFF8400)
+/**
+ * @brief  RAM reserved for the access code at WRITE_FUNCTION_ADDRESS
+ *         (.acfls_code_ram in the linker file)
+ */
+#define FLASH_AC_RAM_SIZE         (0x200U)
+/**
+ * @brief  Command kinds with their own latency statistics
+ */
+#define FLASH_CMD_PROGRAM        (0U)
+#define FLASH_CMD_ERASE_SECTOR   (1U)
+#define FLASH_CMD_ERASE_BLOCK    (2U)
+#define FLASH_CMD_KINDS          (3U)
+/**
+ * @brief  Latency histogram bins: bin n counts commands of 2^n..2^(n+1)-1 cycles
+ */
+#define FLASH_HIST_BINS          (32U)
 void Mem_43_INFLS_IPW_LoadAc(void);
 
 void Ftfc_AccessCode(void) __attribute__ ((section (".acmem_43_infls_code_rom")));
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief  Latency of one command kind, in core cycles (launch to CCIF)
+ */
+typedef struct
+{
+    uint32_t Count;
+    uint32_t Errors;                   /* FSTAT ACCERR, FPVIOL or MGSTAT0 set */
+    uint32_t MinCycles;
+    uint32_t MaxCycles;
+    uint64_t TotalCycles;
+    uint32_t Hist[FLASH_HIST_BINS];
+} Flash_CmdStats_t;
+
+/**
+ * @brief  Flash command statistics since reset
+ */
+typedef struct
+{
+    Flash_CmdStats_t Cmd[FLASH_CMD_KINDS];
+    uint32_t         AccErr;
+    uint32_t         FpViol;
+    uint32_t         MgStat0;
+    uint32_t         Timeouts;      /* CCIF not set within FLASH_CMD_TIMEOUT_MS */
+} Flash_Stats_t;
+
+/**
+ * @brief  One run of phrases for Flash_ProgramBatch
+ */
+typedef struct
+{
+    uint32_t       Addr;                /* CPU address, phrase aligned */
+    const uint8_t *Src;                 /* Phrases * 8 bytes, in RAM */
+    uint32_t       Phrases;
+} Flash_ProgramDesc_t;
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -39,16 +105,28 @@ uint32_t Read_FlashAddress(uint32_t Addr);
  * @param Addr: address to flash data to flash
  * @param *Data: input data need to flash data into flash
  * @return
- * return 1: if success
+ * return 1: if success, 0: FSTAT reports ACCERR, FPVIOL or MGSTAT0
  */
 uint8_t Program_LongWord_8B(uint32_t Addr,uint8_t *Data);
 
+/*!
+ * @brief
+ * program a list of phrase runs with the RAM kernel: one flash to RAM
+ * switch for the whole list instead of one per phrase. Descriptors and
+ * data must be in RAM. Every phrase is counted in the PROGRAM statistics.
+ * @param Desc: descriptor list
+ * @param Count: number of descriptors
+ * @return
+ * return 1: if every phrase programmed, 0: stopped at an FSTAT error
+ */
+uint8_t Flash_ProgramBatch(const Flash_ProgramDesc_t *Desc, uint32_t Count);
+
 /*!
  * @brief
  * erase a sector in flash
  * @param Addr: address to erase
  * @return
- * return 1: if success
+ * return 1: if success, 0: FSTAT reports ACCERR, FPVIOL or MGSTAT0
  */
 uint8_t Erase_Sector(uint32_t Addr);
 
@@ -57,8 +135,41 @@ uint8_t Erase_Sector(uint32_t Addr);
  * erase multi sectors in flash
  * @param Addr: address to erase
  * @return
- * return 1: if success
+ * return 1: if every sector erased, 0: otherwise
  */
 uint8_t Erase_Multi_Sector(uint32_t Addr,uint8_t Size);
 
+/*!
+ * @brief
+ * erase a range of flash, a block at a time where the range covers a whole
+ * block and a sector at a time elsewhere
+ * @param Start: first address, sector aligned
+ * @param End: end address (exclusive), sector aligned, same region as Start
+ * @return
+ * return 1: if every command succeeded, 0: bad range or FSTAT error
+ */
+uint8_t Flash_EraseRange(uint32_t Start, uint32_t End);
+
+/*!
+ * @brief
+ * number of program/erase commands launched since reset
+ * @return
+ * return command count
+ */
+uint32_t Flash_GetCommandCount(void);
+
+/*!
+ * @brief
+ * per command latency histograms and FSTAT error counts
+ * @return
+ * return pointer to the statistics (updated by every command)
+ */
+const Flash_Stats_t *Flash_GetStats(void);
+
+/*!
+ * @brief
+ * clear the latency histograms and error counts
+ */
+void Flash_ResetStats(void);
+
 #endif
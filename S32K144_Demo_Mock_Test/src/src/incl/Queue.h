@@ -24,6 +24,7 @@ extern "C"
 
 #define QUEUE_MAX_ELEMENTS         (4U)
 #define QUEUE_MAX_LINE_LENGTH      (256U)
+#define QUEUE_LINE_BUFFER_SIZE     (256U)    /* longest assembled line + 1 */
 
 /*******************************************************************************
  * Types
@@ -37,7 +38,8 @@ typedef enum
     QUEUE_STATUS_ERROR,
     QUEUE_STATUS_FULL,
     QUEUE_STATUS_EMPTY,
-    QUEUE_STATUS_PARAM
+    QUEUE_STATUS_PARAM,
+    QUEUE_STATUS_TRUNCATED      /* element popped, but longer than the output buffer */
 } Queue_Status_t;
 
 /**
@@ -60,6 +62,31 @@ typedef struct
     uint32_t        count;
 } Queue_Srec_t;
 
+/**
+ * @brief Result of feeding one received character to the line assembler
+ */
+typedef enum
+{
+    QUEUE_LINE_NONE = 0,        /* character stored, or empty line ignored */
+    QUEUE_LINE_PUSHED,          /* line end: the line was pushed to the queue */
+    QUEUE_LINE_DROPPED          /* line end: the line did not fit and was dropped */
+} Queue_LineEvent_t;
+
+/**
+ * @brief Line assembler for received UART characters
+ */
+typedef struct
+{
+    uint8_t  buffer[QUEUE_LINE_BUFFER_SIZE];
+    uint32_t index;
+    uint8_t  overflow;
+} Queue_Line_t;
+
+/**
+ * @brief Consume one queued line, return 1 if a line was popped
+ */
+typedef uint8_t (*Queue_Drain_t)(Queue_Srec_t *queue);
+
 /*******************************************************************************
  * APIs
  ******************************************************************************/
@@ -68,6 +95,8 @@ Queue_Status_t Queue_Srec_Push(Queue_Srec_t *queue, const uint8_t *line, uint32_
 Queue_Status_t Queue_Srec_Pop(Queue_Srec_t *queue, uint8_t *out_line, uint32_t out_line_max, uint32_t *out_length);
 Queue_Status_t Queue_Srec_IsEmpty(const Queue_Srec_t *queue, uint8_t *is_empty);
 Queue_Status_t Queue_Srec_IsFull(const Queue_Srec_t *queue, uint8_t *is_full);
+Queue_Status_t Queue_Line_Init(Queue_Line_t *line);
+Queue_LineEvent_t Queue_Line_PutChar(Queue_Line_t *line, Queue_Srec_t *queue, uint8_t c, Queue_Drain_t drain);
 
 #ifdef __cplusplus
 }
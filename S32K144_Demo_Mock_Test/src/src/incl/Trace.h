@@ -0,0 +1,83 @@
+/**
+ * @file Trace.h
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Timestamped event trace ring for the UART bootloader
+ * @version 0.1
+ * @date 2026-03-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Build with TRACE_ENABLE=0 to compile every TRACE_EVENT() out (the host
+ * tool does). The ring keeps the last TRACE_RING_SIZE events.
+ *
+ * "#TRACE" dump:
+ *   "TRACE 0xNNNNNNNN\r\n"  number of events
+ *   NNNNNNNN x 8 bytes        oldest first, Trace_Event_t little-endian
+ *   "\r\nEND\r\n"
+ * Decode it with "bltool trace <capture>".
+ */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE               (1)
+#endif
+
+#define TRACE_RING_SIZE            (128U)   /* power of two */
+
+#define TRACE_ARG_MASK             (0x00FFFFFFUL)
+#define TRACE_ID_SHIFT             (24U)
+
+/* Event IDs, *_BEGIN / *_END pairs are id and id + 1 */
+#define TRACE_ID_UART_IRQ          (0x01U)  /* arg: LPUART STAT >> 8 */
+#define TRACE_ID_PARSE_BEGIN       (0x10U)  /* arg: max_len, 0 for Srec_ParseSrecLine */
+#define TRACE_ID_PARSE_END         (0x11U)  /* arg: Srec_Status_t */
+#define TRACE_ID_FLUSH_BEGIN       (0x20U)  /* arg: phrase address */
+#define TRACE_ID_FLUSH_END         (0x21U)  /* arg: bl_status_t */
+#define TRACE_ID_ERASE_BEGIN       (0x30U)  /* arg: FCCOB address */
+#define TRACE_ID_ERASE_END         (0x31U)  /* arg: FSTAT */
+#define TRACE_ID_PROGRAM_BEGIN     (0x40U)  /* arg: FCCOB address */
+#define TRACE_ID_PROGRAM_END       (0x41U)  /* arg: FSTAT */
+
+#if (0 != TRACE_ENABLE)
+#define TRACE_EVENT(id, arg)       Trace_Record((uint8_t)(id), (uint32_t)(arg))
+#else
+#define TRACE_EVENT(id, arg)       ((void)0)
+#endif
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/**
+ * @brief One trace event (8 bytes)
+ */
+typedef struct
+{
+    uint32_t timestamp;      /* DWT CYCCNT */
+    uint32_t info;           /* id << 24 | arg (24 bits) */
+} Trace_Event_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void Trace_Init(void);
+void Trace_Record(uint8_t id, uint32_t arg);
+void Trace_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H_ */
@@ -23,6 +23,29 @@ extern volatile uint32_t        usart_events;
  ===========================================================================================*/
 void USART1_SignalEvent(uint32_t event);
 
+/**
+ * @brief Start interrupt driven reception into the receive ring
+ *
+ * @return int32_t ARM_DRIVER_OK on success, error code otherwise
+ */
+int32_t App_StartReceive(void);
+
+/**
+ * @brief Take one received byte from the receive ring
+ *
+ * @param c Output byte
+ * @return uint8_t 1: byte returned, 0: ring empty
+ */
+uint8_t App_ReadByte(uint8_t *c);
+
+/**
+ * @brief Send raw bytes via UART (may contain NUL)
+ *
+ * @param data Bytes to send
+ * @param len Number of bytes
+ */
+void App_SendBytes(const uint8_t *data, uint32_t len);
+
 /**
  * @brief Send a string via UART
  *
@@ -30,5 +53,12 @@ void USART1_SignalEvent(uint32_t event);
  */
 void App_SendString(const char *str);
 
+/**
+ * @brief Send a 32-bit value as "0xXXXXXXXX" via UART
+ *
+ * @param value Value to send
+ */
+void App_SendHex32(uint32_t value);
+
 
 #endif /* APP_H_ */
@@ -0,0 +1,58 @@
+/**
+ * @file ihex.h
+ * @author Dung (dungpv00@gmail.com)
+ * @brief Intel HEX parsing interface
+ * @version 0.1
+ * @date 2026-03-01
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IHEX_H_
+#define IHEX_H_
+
+#include <stdint.h>
+#include "srec.h"
+
+/*============================================================================
+ * DEFINES
+ =============================================================================*/
+#define IHEX_START_CODE        ((uint8_t)':')
+
+/* Intel HEX record types */
+#define IHEX_TYPE_DATA         (0x00U)
+#define IHEX_TYPE_EOF          (0x01U)
+#define IHEX_TYPE_EXT_SEGMENT  (0x02U)
+#define IHEX_TYPE_START_SEG    (0x03U)
+#define IHEX_TYPE_EXT_LINEAR   (0x04U)
+#define IHEX_TYPE_START_LINEAR (0x05U)
+
+/*
+ * Records are returned as SREC views (decoded in place) so the bootloader handles both
+ * formats the same way:
+ *   00 data         -> type '3', absolute 32-bit address
+ *   01 end of file  -> type '7', address = start address (0 if none)
+ *   02/04 address   -> type IHEX_RECORD_NONE (only updates the context)
+ *   03/05 start     -> type IHEX_RECORD_NONE (remembered for the EOF record)
+ */
+#define IHEX_RECORD_NONE       ((uint8_t)'\0')
+
+/*============================================================================
+ * TYPES
+ =============================================================================*/
+/**
+ * @brief State carried between lines of one Intel HEX file
+ */
+typedef struct
+{
+    uint32_t    base;      /* upper address from the last 02/04 record */
+    uint32_t    entry;     /* start address from the last 03/05 record */
+} ihex_context_t;
+
+/*============================================================================
+ * FUNCTIONS PROTOTYPES
+ =============================================================================*/
+void          Ihex_Init(ihex_context_t *ctx);
+Srec_Status_t Ihex_ParseLine(ihex_context_t *ctx, uint8_t *cmd_buffer, uint32_t max_len, srec_view_t *view);
+
+#endif /* IHEX_H_ */
@@ -42,9 +42,24 @@ typedef struct
     uint32_t    data_len;
 } srec_record_t;
 
+/**
+ * @brief Record decoded in place: data points into the caller's line buffer
+ */
+typedef struct
+{
+    uint8_t         type;
+    uint32_t        address;
+    const uint8_t  *data;
+    uint32_t        data_len;
+} srec_view_t;
+
 /*============================================================================
  * FUNCTIONS PROTOTYPES
  =============================================================================*/
 Srec_Status_t Srec_ParseSrecLine(const uint8_t *cmd_buffer, srec_record_t *rec);
+Srec_Status_t Srec_ParseSrecLineInPlace(uint8_t *cmd_buffer, uint32_t max_len, srec_view_t *view);
+Srec_Status_t Srec_HexToByte(uint8_t high, uint8_t low, uint8_t *out_byte);
+uint32_t      Srec_LineLen(const uint8_t *cmd_buffer);
+uint32_t      Srec_LineLenBounded(const uint8_t *cmd_buffer, uint32_t max_len);
 
 #endif /* SREC_H_ */
@@ -15,66 +15,116 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include "incl/Trace.h"
 
 /*============================================================================
- * LOCAL FUNCTIONS
+ * DEFINES
  =============================================================================*/
+#define SREC_HEX_INVALID       (0xFFU)
+#define SREC_HEX_ROW_INVALID   SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, \
+                               SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, \
+                               SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, \
+                               SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID
+
+/*============================================================================
+ * VARIABLES
+ =============================================================================*/
+/* ASCII -> nibble value, SREC_HEX_INVALID for anything that is not a hex digit */
+static const uint8_t s_hex_value[256] =
+{
+    SREC_HEX_ROW_INVALID,                                              /* 0x00 */
+    SREC_HEX_ROW_INVALID,                                              /* 0x10 */
+    SREC_HEX_ROW_INVALID,                                              /* 0x20 */
+    0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U,                            /* '0'..'9' */
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID, 10U, 11U, 12U, 13U, 14U, 15U,                    /* 'A'..'F' */
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID,
+    SREC_HEX_ROW_INVALID,                                              /* 0x50 */
+    SREC_HEX_INVALID, 10U, 11U, 12U, 13U, 14U, 15U,                    /* 'a'..'f' */
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID, SREC_HEX_INVALID,
+    SREC_HEX_INVALID,
+    SREC_HEX_ROW_INVALID,                                              /* 0x70 */
+    SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID,
+    SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID, SREC_HEX_ROW_INVALID
+};
 
+/*============================================================================
+ * LOCAL FUNCTIONS
+ =============================================================================*/
 /**
- * @brief Convert a hexadecimal character to its numerical value
+ * @brief Get length of SREC line (excluding CR/LF)
  *
- * @param c Hexadecimal character
- * @param val Pointer to store the numerical value
- * @return uint8_t 1 if conversion successful, 0 otherwise
+ * @param cmd_buffer Pointer to SREC line buffer
+ * @return uint32_t Length of SREC line
  */
-static uint8_t Srec_HexCharToVal(uint8_t c, uint8_t *val)
+uint32_t Srec_LineLen(const uint8_t *cmd_buffer)
 {
-    uint8_t result = 0U;
+    uint32_t len;
 
-    if (val != NULL)
+    len = 0U;
+
+    if (cmd_buffer != NULL)
     {
-        if ((c >= '0') && (c <= '9'))
-        {
-            *val = (uint8_t)(c - '0');
-            result = 1U;
-        }
-        else if ((c >= 'A') && (c <= 'F'))
-        {
-            *val = (uint8_t)(c - 'A' + 10);
-            result = 1U;
-        }
-        else if ((c >= 'a') && (c <= 'f'))
+        while ((cmd_buffer[len] != SREC_NUL) &&
+               (cmd_buffer[len] != SREC_CR)  &&
+               (cmd_buffer[len] != SREC_LF))
         {
-            *val = (uint8_t)(c - 'a' + 10);
-            result = 1U;
+            len++;
         }
-        else
+    }
+
+    return len;
+}
+
+/**
+ * @brief Get length of line (excluding CR/LF), reading at most max_len chars
+ *
+ * @param cmd_buffer Pointer to line buffer
+ * @param max_len Number of valid characters in the buffer
+ * @return uint32_t Length of line
+ */
+uint32_t Srec_LineLenBounded(const uint8_t *cmd_buffer, uint32_t max_len)
+{
+    uint32_t len = 0U;
+
+    if (cmd_buffer != NULL)
+    {
+        while ((len < max_len) &&
+               (cmd_buffer[len] != SREC_NUL) &&
+               (cmd_buffer[len] != SREC_CR)  &&
+               (cmd_buffer[len] != SREC_LF))
         {
-            result = 0U;
+            len++;
         }
     }
 
-    return result;
+    return len;
 }
 
+/*============================================================================
+ * API FUNCTIONS
+ =============================================================================*/
 /**
- * @brief Convert two hexadecimal characters to a byte
+ * @brief Convert two hexadecimal characters to a byte (table lookup)
  *
  * @param high High nibble character
  * @param low Low nibble character
  * @param out_byte Pointer to store the resulting byte
  * @return Srec_Status_t Status of the conversion
  */
-static Srec_Status_t Srec_HexToByte(uint8_t high, uint8_t low, uint8_t *out_byte)
+Srec_Status_t Srec_HexToByte(uint8_t high, uint8_t low, uint8_t *out_byte)
 {
     Srec_Status_t status = SREC_STATUS_PARAM;
-    uint8_t hi = 0U;
-    uint8_t lo = 0U;
+    uint8_t hi = s_hex_value[high];
+    uint8_t lo = s_hex_value[low];
 
     if (out_byte != NULL)
     {
-        if ((Srec_HexCharToVal(high, &hi) != 0U) &&
-            (Srec_HexCharToVal(low,  &lo) != 0U))
+        if ((SREC_HEX_INVALID != hi) && (SREC_HEX_INVALID != lo))
         {
             *out_byte = (uint8_t)((hi << 4U) | lo);
             status = SREC_STATUS_OK;
@@ -88,34 +138,6 @@ static Srec_Status_t Srec_HexToByte(uint8_t high, uint8_t low, uint8_t *out_byte
     return status;
 }
 
-/**
- * @brief Get length of SREC line (excluding CR/LF)
- *
- * @param cmd_buffer Pointer to SREC line buffer
- * @return uint32_t Length of SREC line
- */
-uint32_t Srec_LineLen(const uint8_t *cmd_buffer)
-{
-    uint32_t len;
-
-    len = 0U;
-
-    if (cmd_buffer != NULL)
-    {
-        while ((cmd_buffer[len] != SREC_NUL) &&
-               (cmd_buffer[len] != SREC_CR)  &&
-               (cmd_buffer[len] != SREC_LF))
-        {
-            len++;
-        }
-    }
-
-    return len;
-}
-
-/*============================================================================
- * API FUNCTIONS
- =============================================================================*/
 /**
  * @brief Get length of SREC line (excluding CR/LF)
  *
@@ -150,6 +172,8 @@ Srec_Status_t Srec_ParseSrecLine(const uint8_t *cmd_buffer, srec_record_t *rec)
     pos           = 0U;
     expected_ascii_len = 0U;
 
+    TRACE_EVENT(TRACE_ID_PARSE_BEGIN, 0U);
+
     if ((NULL == cmd_buffer) || (NULL == rec))
     {
         /* PARAM */
@@ -184,6 +208,7 @@ Srec_Status_t Srec_ParseSrecLine(const uint8_t *cmd_buffer, srec_record_t *rec)
                 case '2': address_bytes = 3U; break;
                 case '3': address_bytes = 4U; break;
                 case '5': address_bytes = 2U; break; /* count */
+                case '6': address_bytes = 3U; break; /* count (24-bit) */
                 case '7': address_bytes = 4U; break; /* entry */
                 case '8': address_bytes = 3U; break;
                 case '9': address_bytes = 2U; break;
@@ -327,5 +352,130 @@ Srec_Status_t Srec_ParseSrecLine(const uint8_t *cmd_buffer, srec_record_t *rec)
         }
     }
 
+    TRACE_EVENT(TRACE_ID_PARSE_END, status);
+
+    return status;
+}
+
+/**
+ * @brief Parse SREC line decoding the hex pairs in place
+ *
+ * Byte k of the record (count, address, data, checksum) is written to
+ * cmd_buffer[k]; it is read from cmd_buffer[2 + 2k], so decoding never
+ * overwrites characters still to be read. On success view->data points
+ * into cmd_buffer, which must stay untouched while the view is used.
+ *
+ * No character beyond max_len is read, whatever the count field says.
+ *
+ * @param cmd_buffer Pointer to SREC line buffer (modified)
+ * @param max_len Number of valid characters in cmd_buffer
+ * @param view Pointer to output record view
+ * @return Srec_Status_t Status of parsing
+ */
+Srec_Status_t Srec_ParseSrecLineInPlace(uint8_t *cmd_buffer, uint32_t max_len, srec_view_t *view)
+{
+    Srec_Status_t status = SREC_STATUS_PARAM;
+    uint32_t      line_len;
+    uint32_t      address_bytes = 0U;
+    uint32_t      count;
+    uint32_t      address;
+    uint32_t      i;
+    uint8_t       type;
+    uint8_t       sum;
+
+    TRACE_EVENT(TRACE_ID_PARSE_BEGIN, max_len);
+
+    if ((NULL == cmd_buffer) || (NULL == view))
+    {
+        /* PARAM */
+    }
+    else
+    {
+        view->type     = 0U;
+        view->address  = 0U;
+        view->data     = NULL;
+        view->data_len = 0U;
+
+        line_len = Srec_LineLenBounded(cmd_buffer, max_len);
+        type     = 0U;
+        count    = 0U;
+        sum      = 0U;
+        status   = SREC_STATUS_FORMAT;
+
+        if ((line_len >= 4U) && ((uint8_t)'S' == cmd_buffer[0]))
+        {
+            type = cmd_buffer[1];
+
+            /* Address length by record type */
+            switch (type)
+            {
+                case '0': address_bytes = 2U; break; /* header */
+                case '1': address_bytes = 2U; break;
+                case '2': address_bytes = 3U; break;
+                case '3': address_bytes = 4U; break;
+                case '5': address_bytes = 2U; break; /* count */
+                case '6': address_bytes = 3U; break; /* count (24-bit) */
+                case '7': address_bytes = 4U; break; /* entry */
+                case '8': address_bytes = 3U; break;
+                case '9': address_bytes = 2U; break;
+                default:  address_bytes = 0U; break;
+            }
+
+            if (0U != address_bytes)
+            {
+                status = Srec_HexToByte(cmd_buffer[2], cmd_buffer[3], &cmd_buffer[0]);
+            }
+        }
+
+        /* count must cover address + checksum, line must hold 4 + 2*count chars */
+        if (SREC_STATUS_OK == status)
+        {
+            count = cmd_buffer[0];
+
+            if ((count < (address_bytes + 1U)) || (line_len < (4U + (2U * count))))
+            {
+                status = SREC_STATUS_FORMAT;
+            }
+        }
+
+        /* Decode address, data and checksum: bytes 1..count */
+        if (SREC_STATUS_OK == status)
+        {
+            sum = cmd_buffer[0];
+
+            for (i = 1U; i <= count; i++)
+            {
+                status = Srec_HexToByte(cmd_buffer[2U + (2U * i)], cmd_buffer[3U + (2U * i)], &cmd_buffer[i]);
+                if (SREC_STATUS_OK != status)
+                {
+                    break;
+                }
+                sum = (uint8_t)(sum + cmd_buffer[i]);
+            }
+        }
+
+        /* count + address + data + checksum sums to 0xFF */
+        if ((SREC_STATUS_OK == status) && ((uint8_t)0xFFU != sum))
+        {
+            status = SREC_STATUS_CHECKSUM;
+        }
+
+        if (SREC_STATUS_OK == status)
+        {
+            address = 0U;
+            for (i = 1U; i <= address_bytes; i++)
+            {
+                address = (address << 8U) | (uint32_t)cmd_buffer[i];
+            }
+
+            view->type     = type;
+            view->address  = address;
+            view->data     = &cmd_buffer[1U + address_bytes];
+            view->data_len = count - address_bytes - 1U;
+        }
+    }
+
+    TRACE_EVENT(TRACE_ID_PARSE_END, status);
+
     return status;
 }
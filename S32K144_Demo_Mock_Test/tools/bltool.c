@@ -0,0 +1,2030 @@
+/**
+ * @file bltool.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Host-side image tool for the S32K144 UART bootloader
+ * @version 0.1
+ * @date 2026-02-23
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build (host, not part of the S32DS project):
+ *   gcc -O2 -Wall -DBENCH_HOST -DTRACE_ENABLE=0 -o bltool bltool.c ../src/src/srec.c ../src/src/ihex.c \
+ *       ../src/src/Bench.c ../src/src/BootBench.c ../src/src/Crc32.c ../src/src/Queue.c \
+ *       ../src/src/BootProto.c
+ *
+ * Usage:
+ *   bltool delta <old.srec> <old_base> <new.srec> <new_base> <out.txt> [<target.srec>]
+ *       Diff two images and write "#DELTA" followed by S3 records carrying
+ *       the delta stream (see src/src/incl/BootDelta.h). target.srec is the
+ *       image still in the target slot (the one before old), used to count
+ *       the sectors the bootloader actually rewrites.
+ *   bltool compress <in.srec> <base> <out.txt>
+ *       Compress an image and write "#LZ" followed by S3 records carrying
+ *       the LZSS stream (see src/src/incl/BootLz.h).
+ *   bltool optimize <in> <out.srec>
+ *       Rewrite an image as sorted, phrase aligned S3 records of maximum
+ *       length plus S5/S6 count and S7, and compare the flash commands the
+ *       bootloader issues for input and output.
+ *   bltool resume <in> <progress.txt> <out.srec>
+ *       After an interrupted download, take the "MISSING <start> <end>" lines
+ *       the bootloader printed (at start-up or on "#PROGRESS") and write only
+ *       the records inside those ranges, with an S5/S6 count of them and S7.
+ *   bltool loopback <file> [ber] [latency_us] [seed]
+ *       Send every line of a file through the windowed ACK/NAK protocol
+ *       (BootProto.c) over a simulated 19200 baud link that flips bits with
+ *       probability ber (default 1e-4) in both directions. The target takes
+ *       latency_us per frame (default 500). Reports retransmissions, damaged
+ *       payloads that passed the frame check, and the effective throughput
+ *       for every window size 1..BOOTPROTO_WINDOW_SIZE.
+ *   bltool bench <file> [file...]
+ *       Time the record parsers over SREC / Intel HEX files.
+ *   bltool microbench
+ *       Run the firmware micro-benchmarks (BootBench.c) with the host timer,
+ *       same output format as "#BENCH" on target.
+ *   bltool trace <capture> [cpu_hz]
+ *       Decode a raw "#TRACE" dump (see src/src/incl/Trace.h) into a
+ *       timeline; cpu_hz defaults to 80000000.
+ *
+ * Input images may be SREC or Intel HEX (detected per line).
+ */
+/*============================================================================
+ * INCLUDE
+ =============================================================================*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/src/incl/app.h"
+#include "../src/src/incl/BootBench.h"
+#include "../src/src/incl/Bootloader.h"
+#include "../src/src/incl/BootProto.h"
+#include "../src/src/incl/ihex.h"
+#include "../src/src/incl/srec.h"
+#include "../src/src/incl/Trace.h"
+
+/*============================================================================
+ * DEFINES
+ =============================================================================*/
+#define TOOL_SLOT_SIZE             (0x0003B000UL)  /* BOOTSLOT_SIZE */
+#define TOOL_LINE_MAX              (600U)
+#define TOOL_RECORD_DATA           (64U)           /* fits the 256-char line buffer */
+#define TOOL_BAUDRATE              (19200UL)
+#define TOOL_BITS_PER_CHAR         (10UL)          /* 8N1 */
+#define TOOL_BENCH_MIN_NS          (500000000ULL)  /* run each file for >= 0.5 s */
+
+#define TOOL_FLASH_SIZE            (0x00080000UL)  /* P-Flash */
+#define TOOL_SECTOR_SIZE           (0x1000U)
+#define TOOL_PHRASE_SIZE           (8U)
+#define TOOL_BATCH_PHRASES         (64U)           /* PHRASE_BATCH_PHRASES of Bootloader.c */
+#define TOOL_BATCH_RUNS            (8U)            /* PHRASE_BATCH_RUNS of Bootloader.c */
+#define TOOL_OPT_RECORD_DATA       (112U)          /* '@' frame of an S3 line fits 256 chars */
+
+#define TOOL_TRACE_CPU_HZ          (80000000.0)    /* NormalRUNmode_80MHz */
+#define TOOL_TRACE_KINDS           (16U)           /* id >> 4 */
+#define TOOL_TRACE_CAPTURE_MAX     (65536U)
+
+#define TOOL_LOOP_BER              (1e-4)          /* bit error rate per direction */
+#define TOOL_LOOP_LATENCY_US       (500.0)         /* target time per frame (parse + program) */
+#define TOOL_LOOP_TIMEOUT_US       (50000.0)       /* host retransmit timeout */
+#define TOOL_LOOP_FRAMES_MAX       (65536U)
+#define TOOL_LOOP_REPLIES_MAX      (4096U)
+#define TOOL_LOOP_REPLY_LEN        (5U)            /* "Kss\r\n" */
+
+#define TOOL_DELTA_OP_COPY         (0x01U)
+#define TOOL_DELTA_OP_LITERAL      (0x02U)
+#define TOOL_DELTA_OP_SKIP         (0x03U)
+#define TOOL_DELTA_MAX_LEN         (0xFFFFU)
+#define TOOL_DELTA_MIN_SKIP        (8U)
+#define TOOL_DELTA_MIN_COPY        (12U)
+#define TOOL_DELTA_HASH_BITS       (18U)
+#define TOOL_DELTA_HASH_LEN        (8U)
+
+#define TOOL_LZ_WINDOW_SIZE        (1024U)
+#define TOOL_LZ_DIST_BITS          (10U)
+#define TOOL_LZ_MIN_MATCH          (3U)
+#define TOOL_LZ_MAX_MATCH          (TOOL_LZ_MIN_MATCH + 63U)
+
+/*============================================================================
+ * TYPES
+ =============================================================================*/
+/**
+ * @brief Flat image loaded from a record file
+ */
+typedef struct
+{
+    uint8_t  *data;           /* span bytes, 0xFF = not programmed */
+    uint8_t  *used;           /* span bytes, 1 = written by a record */
+    uint32_t  base;
+    uint32_t  span;
+    uint32_t  size;           /* highest written offset + 1 */
+    uint32_t  wire_chars;     /* characters of the source file incl. CR/LF */
+    uint32_t  records;
+    uint32_t  entry;
+    uint32_t  header_len;
+    uint8_t   header[SREC_MAX_DATA_BYTES];
+    int       has_header;
+} Tool_Image_t;
+
+/**
+ * @brief Growable byte buffer
+ */
+typedef struct
+{
+    uint8_t  *data;
+    uint32_t  len;
+    uint32_t  cap;
+} Tool_Buffer_t;
+
+/**
+ * @brief Flash commands the bootloader issues for a record file
+ *
+ * Mirrors the phrase cache of Bootloader.c: a phrase is flushed whenever a
+ * byte of another phrase arrives, a sector is erased on first use. Programmed
+ * phrases are batched like Bootloader.c: one RAM kernel call per sector left,
+ * full batch and end of stream.
+ */
+typedef struct
+{
+    uint8_t  *phrase_done;    /* one flag per phrase of P-Flash */
+    uint8_t  *sector_done;    /* one flag per sector of P-Flash */
+    uint32_t  cur_base;
+    uint8_t   cur_data[TOOL_PHRASE_SIZE];
+    int       cur_valid;
+    uint32_t  records;
+    uint32_t  flushes;        /* PhraseCache_Flush calls */
+    uint32_t  programs;       /* phrase program commands */
+    uint32_t  batches;        /* Flash_ProgramBatch calls */
+    uint32_t  batch_sector;   /* sector of the phrases in the batch */
+    uint32_t  batch_phrases;
+    uint32_t  batch_runs;
+    uint32_t  batch_next;     /* address after the last run */
+    uint32_t  erases;         /* Erase_Sector commands */
+    uint32_t  revisits;       /* phrase flushed twice: rejected by the bootloader */
+    int       count_error;    /* S5/S6 did not match: BL_ERR_COUNT on target */
+} Tool_FlashSim_t;
+
+/**
+ * @brief One reply line on its way back to the host
+ */
+typedef struct
+{
+    double at_us;             /* arrival at the host */
+    char   text[TOOL_LOOP_REPLY_LEN + 1U];
+} Tool_LoopReply_t;
+
+/**
+ * @brief Loopback link between the host sender and BootProto
+ */
+typedef struct
+{
+    char            **lines;          /* payloads to send */
+    uint32_t         *lens;
+    uint32_t          count;
+    double            ber;
+    double            latency_us;
+    double            char_us;
+    uint64_t          rng;
+    Tool_LoopReply_t  replies[TOOL_LOOP_REPLIES_MAX];
+    uint32_t          reply_head;
+    uint32_t          reply_tail;
+    double            target_free_us; /* target busy with the previous frame until */
+    double            reverse_free_us;/* reply link busy until */
+    double            now_us;         /* time the target handles the current frame */
+    uint32_t          delivered;
+    uint32_t          undetected;     /* delivered payloads that differ from the sent one */
+} Tool_Loop_t;
+
+/**
+ * @brief Called for every record of a file
+ */
+typedef int (*Tool_RecordFn_t)(void *ctx, const srec_view_t *rec);
+
+/*============================================================================
+ * LOCAL FUNCTIONS
+ =============================================================================*/
+/**
+ * @brief Append bytes to a buffer
+ */
+static void Tool_BufferAppend(Tool_Buffer_t *b, const uint8_t *data, uint32_t len)
+{
+    if ((b->len + len) > b->cap)
+    {
+        b->cap  = (b->cap + len) * 2U;
+        b->data = (uint8_t *)realloc(b->data, b->cap);
+        if (NULL == b->data)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    memcpy(&b->data[b->len], data, len);
+    b->len += len;
+}
+
+/**
+ * @brief Parse an SREC or Intel HEX file and call fn for every record
+ *
+ * @return int 0 on success
+ */
+static int Tool_ForEachRecord(const char *path, Tool_RecordFn_t fn, void *ctx, uint32_t *wire_chars)
+{
+    FILE          *f;
+    char           line[TOOL_LINE_MAX];
+    srec_view_t    rec;
+    ihex_context_t ihex;
+    Srec_Status_t  st;
+    uint32_t       line_no = 0U;
+    int            result  = 0;
+
+    Ihex_Init(&ihex);
+
+    f = fopen(path, "r");
+    if (NULL == f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while ((0 == result) && (NULL != fgets(line, sizeof(line), f)))
+    {
+        line_no++;
+
+        if (NULL != wire_chars)
+        {
+            *wire_chars += (uint32_t)strcspn(line, "\r\n") + 2U;
+        }
+
+        if ('S' == line[0])
+        {
+            st = Srec_ParseSrecLineInPlace((uint8_t *)line, sizeof(line), &rec);
+        }
+        else if (IHEX_START_CODE == (uint8_t)line[0])
+        {
+            st = Ihex_ParseLine(&ihex, (uint8_t *)line, sizeof(line), &rec);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (SREC_STATUS_OK != st)
+        {
+            fprintf(stderr, "%s:%u: bad record\n", path, (unsigned)line_no);
+            result = -1;
+        }
+        else
+        {
+            result = fn(ctx, &rec);
+        }
+    }
+
+    fclose(f);
+
+    return result;
+}
+
+/**
+ * @brief Record callback of Tool_LoadImage
+ */
+static int Tool_LoadRecord(void *ctx, const srec_view_t *rec)
+{
+    Tool_Image_t *img    = (Tool_Image_t *)ctx;
+    uint32_t      end    = rec->address + rec->data_len;
+    int           result = 0;
+
+    if ((rec->type >= '1') && (rec->type <= '3') && (0U != rec->data_len))
+    {
+        if ((rec->address < img->base) || (end > (img->base + img->span)))
+        {
+            fprintf(stderr, "record 0x%08X outside 0x%08X..0x%08X\n", (unsigned)rec->address,
+                    (unsigned)img->base, (unsigned)(img->base + img->span));
+            result = -1;
+        }
+        else
+        {
+            memcpy(&img->data[rec->address - img->base], rec->data, rec->data_len);
+            memset(&img->used[rec->address - img->base], 1, rec->data_len);
+            if ((end - img->base) > img->size)
+            {
+                img->size = end - img->base;
+            }
+            img->records++;
+        }
+    }
+    else if (('0' == rec->type) && (0 == img->has_header))
+    {
+        memcpy(img->header, rec->data, rec->data_len);
+        img->header_len = rec->data_len;
+        img->has_header = 1;
+    }
+    else if ((rec->type >= '7') && (rec->type <= '9'))
+    {
+        img->entry = rec->address;
+    }
+    else
+    {
+        /* S5/S6 and Intel HEX address records carry no image data */
+    }
+
+    return result;
+}
+
+/**
+ * @brief Load an SREC or Intel HEX file into a flat image of span bytes at base
+ *
+ * @return int 0 on success
+ */
+static int Tool_LoadImage(const char *path, uint32_t base, uint32_t span, Tool_Image_t *img)
+{
+    memset(img, 0, sizeof(*img));
+    img->base = base;
+    img->span = span;
+    img->data = (uint8_t *)malloc(span);
+    img->used = (uint8_t *)calloc(span, 1U);
+    if ((NULL == img->data) || (NULL == img->used))
+    {
+        return -1;
+    }
+    memset(img->data, 0xFF, span);
+
+    return Tool_ForEachRecord(path, Tool_LoadRecord, img, &img->wire_chars);
+}
+
+/**
+ * @brief Release an image
+ */
+static void Tool_FreeImage(Tool_Image_t *img)
+{
+    free(img->data);
+    free(img->used);
+}
+
+/**
+ * @brief Write one SREC record of the given type
+ *
+ * @return uint32_t Number of characters written incl. CR/LF
+ */
+static uint32_t Tool_WriteRecord(FILE *f, char type, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+    uint32_t addr_bytes;
+    uint8_t  count;
+    uint8_t  sum;
+    uint32_t i;
+
+    switch (type)
+    {
+        case '2': case '6': case '8': addr_bytes = 3U; break;
+        case '3': case '7':           addr_bytes = 4U; break;
+        default:                      addr_bytes = 2U; break;
+    }
+
+    count = (uint8_t)(addr_bytes + len + 1U);
+    sum   = count;
+
+    fprintf(f, "S%c%02X", type, count);
+    for (i = addr_bytes; i > 0U; i--)
+    {
+        fprintf(f, "%02X", (unsigned)((addr >> (8U * (i - 1U))) & 0xFFU));
+        sum = (uint8_t)(sum + (addr >> (8U * (i - 1U))));
+    }
+
+    for (i = 0U; i < len; i++)
+    {
+        fprintf(f, "%02X", data[i]);
+        sum = (uint8_t)(sum + data[i]);
+    }
+
+    fprintf(f, "%02X\r\n", (uint8_t)~sum);
+
+    return 4U + (2U * (uint32_t)count) + 2U;
+}
+
+/**
+ * @brief Write a byte stream as S3 records (address = stream offset)
+ *
+ * @return uint32_t Number of characters written
+ */
+static uint32_t Tool_WriteStream(FILE *f, const Tool_Buffer_t *b)
+{
+    uint32_t chars = 0U;
+    uint32_t off;
+    uint32_t n;
+
+    for (off = 0U; off < b->len; off += n)
+    {
+        n = b->len - off;
+        if (n > TOOL_RECORD_DATA)
+        {
+            n = TOOL_RECORD_DATA;
+        }
+        chars += Tool_WriteRecord(f, '3', off, &b->data[off], n);
+    }
+
+    return chars;
+}
+
+/**
+ * @brief Print wire size and estimated transfer time of an update
+ */
+static void Tool_PrintWire(const char *what, uint32_t chars)
+{
+    printf("%-12s %8u chars  %8.1f s @ %lu baud\n", what, (unsigned)chars,
+           ((double)chars * (double)TOOL_BITS_PER_CHAR) / (double)TOOL_BAUDRATE, (unsigned long)TOOL_BAUDRATE);
+}
+
+/*============================================================================
+ * DELTA
+ =============================================================================*/
+/**
+ * @brief Hash of TOOL_DELTA_HASH_LEN bytes
+ */
+static uint32_t Tool_DeltaHash(const uint8_t *p)
+{
+    uint32_t h = 2166136261UL;
+    uint32_t i;
+
+    for (i = 0U; i < TOOL_DELTA_HASH_LEN; i++)
+    {
+        h = (h ^ p[i]) * 16777619UL;
+    }
+
+    return h >> (32U - TOOL_DELTA_HASH_BITS);
+}
+
+/**
+ * @brief Emit a pending literal run
+ */
+static void Tool_DeltaFlushLiteral(Tool_Buffer_t *out, const uint8_t *data, uint32_t *lit_start, uint32_t pos)
+{
+    uint8_t  hdr[3];
+    uint32_t n;
+
+    while (*lit_start < pos)
+    {
+        n = pos - *lit_start;
+        if (n > TOOL_DELTA_MAX_LEN)
+        {
+            n = TOOL_DELTA_MAX_LEN;
+        }
+
+        hdr[0] = TOOL_DELTA_OP_LITERAL;
+        hdr[1] = (uint8_t)n;
+        hdr[2] = (uint8_t)(n >> 8);
+        Tool_BufferAppend(out, hdr, 3U);
+        Tool_BufferAppend(out, &data[*lit_start], n);
+        *lit_start += n;
+    }
+}
+
+/**
+ * @brief Diff two images into a delta op stream
+ */
+static void Tool_DeltaEncode(const Tool_Image_t *old_img, const Tool_Image_t *new_img, Tool_Buffer_t *out)
+{
+    int32_t  *table;
+    uint32_t  pos       = 0U;
+    uint32_t  lit_start = 0U;
+    uint32_t  i;
+    uint32_t  n;
+    uint32_t  cand;
+    uint8_t   op[7];
+
+    table = (int32_t *)malloc(sizeof(int32_t) << TOOL_DELTA_HASH_BITS);
+    memset(table, 0xFF, sizeof(int32_t) << TOOL_DELTA_HASH_BITS);
+
+    for (i = 0U; (i + TOOL_DELTA_HASH_LEN) <= old_img->size; i++)
+    {
+        table[Tool_DeltaHash(&old_img->data[i])] = (int32_t)i;
+    }
+
+    while (pos < new_img->size)
+    {
+        /* Same bytes at the same offset -> SKIP */
+        n = 0U;
+        while (((pos + n) < new_img->size) && ((pos + n) < old_img->size) &&
+               (new_img->data[pos + n] == old_img->data[pos + n]) && (n < TOOL_DELTA_MAX_LEN))
+        {
+            n++;
+        }
+
+        if (n >= TOOL_DELTA_MIN_SKIP)
+        {
+            Tool_DeltaFlushLiteral(out, new_img->data, &lit_start, pos);
+            op[0] = TOOL_DELTA_OP_SKIP;
+            op[1] = (uint8_t)n;
+            op[2] = (uint8_t)(n >> 8);
+            Tool_BufferAppend(out, op, 3U);
+            pos      += n;
+            lit_start = pos;
+            continue;
+        }
+
+        /* Same bytes elsewhere in the old image -> COPY */
+        n = 0U;
+        if ((pos + TOOL_DELTA_HASH_LEN) <= new_img->size)
+        {
+            cand = (uint32_t)table[Tool_DeltaHash(&new_img->data[pos])];
+
+            if (0xFFFFFFFFUL != cand)
+            {
+                while (((pos + n) < new_img->size) && ((cand + n) < old_img->size) &&
+                       (new_img->data[pos + n] == old_img->data[cand + n]) && (n < TOOL_DELTA_MAX_LEN))
+                {
+                    n++;
+                }
+            }
+        }
+
+        if (n >= TOOL_DELTA_MIN_COPY)
+        {
+            Tool_DeltaFlushLiteral(out, new_img->data, &lit_start, pos);
+            op[0] = TOOL_DELTA_OP_COPY;
+            op[1] = (uint8_t)cand;
+            op[2] = (uint8_t)(cand >> 8);
+            op[3] = (uint8_t)(cand >> 16);
+            op[4] = (uint8_t)(cand >> 24);
+            op[5] = (uint8_t)n;
+            op[6] = (uint8_t)(n >> 8);
+            Tool_BufferAppend(out, op, 7U);
+            pos      += n;
+            lit_start = pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    Tool_DeltaFlushLiteral(out, new_img->data, &lit_start, pos);
+
+    free(table);
+}
+
+/**
+ * @brief Number of sectors in [0, size) whose content differs between two images
+ */
+static uint32_t Tool_DeltaSectors(const Tool_Image_t *a, const Tool_Image_t *b, uint32_t size)
+{
+    uint32_t count = 0U;
+    uint32_t off;
+    uint32_t n;
+
+    for (off = 0U; off < size; off += TOOL_SECTOR_SIZE)
+    {
+        n = TOOL_SECTOR_SIZE;
+        if ((off + n) > a->span)
+        {
+            n = a->span - off;
+        }
+
+        count += (0 != memcmp(&a->data[off], &b->data[off], n)) ? 1U : 0U;
+    }
+
+    return count;
+}
+
+/**
+ * @brief "delta" command
+ */
+static int Tool_CmdDelta(int argc, char **argv)
+{
+    Tool_Image_t  old_img;
+    Tool_Image_t  new_img;
+    Tool_Image_t  target_img;
+    Tool_Buffer_t stream = { NULL, 0U, 0U };
+    FILE         *f;
+    uint32_t      chars;
+    uint32_t      new_base;
+    uint32_t      sectors;
+
+    if ((argc != 7) && (argc != 8))
+    {
+        fprintf(stderr, "usage: bltool delta <old.srec> <old_base> <new.srec> <new_base> <out.txt> [<target.srec>]\n");
+        return 2;
+    }
+
+    new_base = (uint32_t)strtoul(argv[5], NULL, 0);
+
+    if ((0 != Tool_LoadImage(argv[2], (uint32_t)strtoul(argv[3], NULL, 0), TOOL_SLOT_SIZE, &old_img)) ||
+        (0 != Tool_LoadImage(argv[4], new_base, TOOL_SLOT_SIZE, &new_img)))
+    {
+        return 1;
+    }
+
+    /* Image in the target slot, linked for the target slot like new.srec */
+    if ((8 == argc) && (0 != Tool_LoadImage(argv[7], new_base, TOOL_SLOT_SIZE, &target_img)))
+    {
+        return 1;
+    }
+
+    Tool_DeltaEncode(&old_img, &new_img, &stream);
+
+    f = fopen(argv[6], "wb");
+    if (NULL == f)
+    {
+        perror(argv[6]);
+        return 1;
+    }
+
+    fprintf(f, "#DELTA\r\n");
+    chars  = 8U;
+    chars += Tool_WriteStream(f, &stream);
+    chars += Tool_WriteRecord(f, '7', new_base, NULL, 0U);
+    fclose(f);
+
+    printf("image        %8u bytes\n", (unsigned)new_img.size);
+    printf("delta stream %8u bytes\n", (unsigned)stream.len);
+    Tool_PrintWire("plain", new_img.wire_chars);
+    Tool_PrintWire("delta", chars);
+
+    /* The bootloader skips a sector only when the target slot already holds
+     * it, and the target slot holds the image before old, not old */
+    sectors = (new_img.size + TOOL_SECTOR_SIZE - 1U) / TOOL_SECTOR_SIZE;
+    printf("sectors      %8u in the new image\n", (unsigned)sectors);
+    printf("  changed    %8u since the active image\n",
+           (unsigned)Tool_DeltaSectors(&new_img, &old_img, new_img.size));
+    if (8 == argc)
+    {
+        printf("  rewritten  %8u in the target slot (erase + program)\n",
+               (unsigned)Tool_DeltaSectors(&new_img, &target_img, new_img.size));
+        Tool_FreeImage(&target_img);
+    }
+    else
+    {
+        printf("  rewritten  %8u in the target slot if it holds no image (pass <target.srec>)\n",
+               (unsigned)sectors);
+    }
+
+    free(stream.data);
+    Tool_FreeImage(&old_img);
+    Tool_FreeImage(&new_img);
+
+    return 0;
+}
+
+/*============================================================================
+ * COMPRESS
+ =============================================================================*/
+/**
+ * @brief LZSS-compress a buffer in the BootLz stream format
+ */
+static void Tool_LzEncode(const uint8_t *in, uint32_t len, Tool_Buffer_t *out)
+{
+    uint8_t  group[1U + (8U * 2U)];
+    uint32_t group_len = 1U;
+    uint32_t items     = 0U;
+    uint32_t pos       = 0U;
+    uint32_t best_len;
+    uint32_t best_dist;
+    uint32_t dist;
+    uint32_t n;
+    uint32_t max;
+    uint16_t token;
+
+    group[0] = 0U;
+
+    while (pos < len)
+    {
+        best_len  = 0U;
+        best_dist = 0U;
+        max       = len - pos;
+        if (max > TOOL_LZ_MAX_MATCH)
+        {
+            max = TOOL_LZ_MAX_MATCH;
+        }
+
+        for (dist = 1U; (dist <= TOOL_LZ_WINDOW_SIZE) && (dist <= pos); dist++)
+        {
+            n = 0U;
+            while ((n < max) && (in[pos + n] == in[pos + n - dist]))
+            {
+                n++;
+            }
+
+            if (n > best_len)
+            {
+                best_len  = n;
+                best_dist = dist;
+                if (n == max)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (best_len >= TOOL_LZ_MIN_MATCH)
+        {
+            token = (uint16_t)(((best_len - TOOL_LZ_MIN_MATCH) << TOOL_LZ_DIST_BITS) | (best_dist - 1U));
+            group[group_len++] = (uint8_t)token;
+            group[group_len++] = (uint8_t)(token >> 8);
+            pos += best_len;
+        }
+        else
+        {
+            group[0] |= (uint8_t)(1U << items);
+            group[group_len++] = in[pos];
+            pos++;
+        }
+
+        items++;
+        if (8U == items)
+        {
+            Tool_BufferAppend(out, group, group_len);
+            group[0]  = 0U;
+            group_len = 1U;
+            items     = 0U;
+        }
+    }
+
+    if (0U != items)
+    {
+        Tool_BufferAppend(out, group, group_len);
+    }
+}
+
+/**
+ * @brief "compress" command
+ */
+static int Tool_CmdCompress(int argc, char **argv)
+{
+    Tool_Image_t  img;
+    Tool_Buffer_t stream = { NULL, 0U, 0U };
+    FILE         *f;
+    uint32_t      chars;
+    uint32_t      base;
+
+    if (argc != 5)
+    {
+        fprintf(stderr, "usage: bltool compress <in.srec> <base> <out.txt>\n");
+        return 2;
+    }
+
+    base = (uint32_t)strtoul(argv[3], NULL, 0);
+
+    if (0 != Tool_LoadImage(argv[2], base, TOOL_SLOT_SIZE, &img))
+    {
+        return 1;
+    }
+
+    Tool_LzEncode(img.data, img.size, &stream);
+
+    f = fopen(argv[4], "wb");
+    if (NULL == f)
+    {
+        perror(argv[4]);
+        return 1;
+    }
+
+    fprintf(f, "#LZ\r\n");
+    chars  = 5U;
+    chars += Tool_WriteStream(f, &stream);
+    chars += Tool_WriteRecord(f, '7', base, NULL, 0U);
+    fclose(f);
+
+    printf("image        %8u bytes\n", (unsigned)img.size);
+    printf("compressed   %8u bytes (%u%%)\n", (unsigned)stream.len,
+           (unsigned)((0U != img.size) ? ((stream.len * 100U) / img.size) : 0U));
+    Tool_PrintWire("plain", img.wire_chars);
+    Tool_PrintWire("compressed", chars);
+
+    free(stream.data);
+    Tool_FreeImage(&img);
+
+    return 0;
+}
+
+/*============================================================================
+ * OPTIMIZE
+ =============================================================================*/
+/**
+ * @brief Program the simulated batch
+ */
+static void Tool_SimFlushBatch(Tool_FlashSim_t *sim)
+{
+    if (0U != sim->batch_phrases)
+    {
+        sim->batches++;
+        sim->batch_phrases = 0U;
+        sim->batch_runs    = 0U;
+    }
+}
+
+/**
+ * @brief Flush the simulated phrase cache
+ */
+static void Tool_SimFlush(Tool_FlashSim_t *sim)
+{
+    uint32_t sector = sim->cur_base / TOOL_SECTOR_SIZE;
+    uint32_t phrase = sim->cur_base / TOOL_PHRASE_SIZE;
+    uint32_t i;
+
+    if (0 != sim->cur_valid)
+    {
+        sim->flushes++;
+
+        if (sector != sim->batch_sector)
+        {
+            Tool_SimFlushBatch(sim);
+            sim->batch_sector = sector;
+        }
+
+        if (0U == sim->sector_done[sector])
+        {
+            sim->sector_done[sector] = 1U;
+            sim->erases++;
+        }
+
+        if (0U != sim->phrase_done[phrase])
+        {
+            sim->revisits++;
+        }
+        sim->phrase_done[phrase] = 1U;
+
+        for (i = 0U; i < TOOL_PHRASE_SIZE; i++)
+        {
+            if (0xFFU != sim->cur_data[i])
+            {
+                /* All-0xFF phrases match erased flash and are skipped */
+                sim->programs++;
+
+                if ((TOOL_BATCH_PHRASES == sim->batch_phrases) ||
+                    ((sim->cur_base != sim->batch_next) && (TOOL_BATCH_RUNS == sim->batch_runs)))
+                {
+                    Tool_SimFlushBatch(sim);
+                }
+                if ((0U == sim->batch_phrases) || (sim->cur_base != sim->batch_next))
+                {
+                    sim->batch_runs++;
+                }
+                sim->batch_phrases++;
+                sim->batch_next = sim->cur_base + TOOL_PHRASE_SIZE;
+                break;
+            }
+        }
+
+        sim->cur_valid = 0;
+    }
+}
+
+/**
+ * @brief Record callback of Tool_Simulate
+ */
+static int Tool_SimRecord(void *ctx, const srec_view_t *rec)
+{
+    Tool_FlashSim_t *sim = (Tool_FlashSim_t *)ctx;
+    uint32_t         addr;
+    uint32_t         i;
+
+    if ((rec->type >= '1') && (rec->type <= '3'))
+    {
+        sim->records++;
+
+        for (i = 0U; i < rec->data_len; i++)
+        {
+            addr = rec->address + i;
+            if (addr >= TOOL_FLASH_SIZE)
+            {
+                continue;
+            }
+
+            if ((0 != sim->cur_valid) && ((addr & ~(TOOL_PHRASE_SIZE - 1U)) != sim->cur_base))
+            {
+                Tool_SimFlush(sim);
+            }
+
+            if (0 == sim->cur_valid)
+            {
+                sim->cur_valid = 1;
+                sim->cur_base  = addr & ~(TOOL_PHRASE_SIZE - 1U);
+                memset(sim->cur_data, 0xFF, TOOL_PHRASE_SIZE);
+            }
+
+            sim->cur_data[addr - sim->cur_base] = rec->data[i];
+        }
+    }
+    else if (('5' == rec->type) || ('6' == rec->type))
+    {
+        /* Same check as Bootloader_HandleRecord */
+        if (rec->address != sim->records)
+        {
+            sim->count_error = 1;
+        }
+    }
+    else if ((rec->type >= '7') && (rec->type <= '9'))
+    {
+        Tool_SimFlush(sim);
+        Tool_SimFlushBatch(sim);
+    }
+    else
+    {
+        /* No flash access */
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Count the flash commands the bootloader issues for a file
+ *
+ * @return int 0 on success
+ */
+static int Tool_Simulate(const char *path, Tool_FlashSim_t *sim)
+{
+    int result;
+
+    memset(sim, 0, sizeof(*sim));
+    sim->batch_sector = 0xFFFFFFFFUL;
+    sim->phrase_done = (uint8_t *)calloc(TOOL_FLASH_SIZE / TOOL_PHRASE_SIZE, 1U);
+    sim->sector_done = (uint8_t *)calloc(TOOL_FLASH_SIZE / TOOL_SECTOR_SIZE, 1U);
+
+    result = Tool_ForEachRecord(path, Tool_SimRecord, sim, NULL);
+    Tool_SimFlush(sim);
+    Tool_SimFlushBatch(sim);
+
+    free(sim->phrase_done);
+    free(sim->sector_done);
+
+    return result;
+}
+
+/**
+ * @brief Print the flash command estimate of a file
+ */
+static void Tool_PrintSim(const char *what, const Tool_FlashSim_t *sim, uint32_t chars)
+{
+    printf("%-8s %6u records %8u chars  %6u flushes %6u programs %5u batches %4u erases %4u rejected phrases\n",
+           what, (unsigned)sim->records, (unsigned)chars, (unsigned)sim->flushes,
+           (unsigned)sim->programs, (unsigned)sim->batches, (unsigned)sim->erases, (unsigned)sim->revisits);
+}
+
+/**
+ * @brief Check if any byte of a phrase was written by a record
+ */
+static int Tool_PhraseUsed(const Tool_Image_t *img, uint32_t off)
+{
+    uint32_t i;
+    int      used = 0;
+
+    for (i = 0U; (i < TOOL_PHRASE_SIZE) && ((off + i) < img->span); i++)
+    {
+        used |= img->used[off + i];
+    }
+
+    return used;
+}
+
+/**
+ * @brief Write the used phrases of [start, end) as phrase aligned S3 records
+ *        of maximum length that never cross a sector
+ *
+ * Whole phrases only: gaps inside a phrase are padded with 0xFF, which is
+ * what the phrase cache of the bootloader programs for them anyway. With f
+ * NULL the records are only counted.
+ *
+ * @return uint32_t Number of characters written
+ */
+static uint32_t Tool_WriteRange(FILE *f, const Tool_Image_t *img, uint32_t start, uint32_t end,
+                                uint32_t *records)
+{
+    uint32_t chars = 0U;
+    uint32_t off   = start & ~(TOOL_PHRASE_SIZE - 1U);
+    uint32_t stop;
+    uint32_t n;
+
+    if (end > img->size)
+    {
+        end = img->size;
+    }
+
+    while (off < end)
+    {
+        if (0 == Tool_PhraseUsed(img, off))
+        {
+            off += TOOL_PHRASE_SIZE;
+            continue;
+        }
+
+        stop = off;
+        while ((stop < end) && (0 != Tool_PhraseUsed(img, stop)) &&
+               ((stop - off) < TOOL_OPT_RECORD_DATA) &&
+               ((stop == off) || (0U != (stop % TOOL_SECTOR_SIZE))))
+        {
+            stop += TOOL_PHRASE_SIZE;
+        }
+
+        n = stop - off;
+        if ((off + n) > img->span)
+        {
+            n = img->span - off;
+        }
+
+        if (NULL != f)
+        {
+            chars += Tool_WriteRecord(f, '3', off, &img->data[off], n);
+        }
+        (*records)++;
+        off = stop;
+    }
+
+    return chars;
+}
+
+/**
+ * @brief Write the count record of the data records sent so far
+ *
+ * S6 (24-bit count) only when S5 cannot hold it; both are checked by the
+ * bootloader.
+ *
+ * @return uint32_t Number of characters written
+ */
+static uint32_t Tool_WriteCount(FILE *f, uint32_t records)
+{
+    return Tool_WriteRecord(f, (records <= 0xFFFFU) ? '5' : '6', records, NULL, 0U);
+}
+
+/**
+ * @brief "optimize" command: rewrite an image as sorted, phrase aligned,
+ *        maximum length S3 records that never cross a sector
+ */
+static int Tool_CmdOptimize(int argc, char **argv)
+{
+    Tool_Image_t    img;
+    Tool_FlashSim_t before;
+    Tool_FlashSim_t after;
+    FILE           *f;
+    uint32_t        chars   = 0U;
+    uint32_t        records = 0U;
+
+    if (argc != 4)
+    {
+        fprintf(stderr, "usage: bltool optimize <in.srec|in.hex> <out.srec>\n");
+        return 2;
+    }
+
+    if ((0 != Tool_LoadImage(argv[2], 0U, TOOL_FLASH_SIZE, &img)) ||
+        (0 != Tool_Simulate(argv[2], &before)))
+    {
+        return 1;
+    }
+
+    f = fopen(argv[3], "wb");
+    if (NULL == f)
+    {
+        perror(argv[3]);
+        return 1;
+    }
+
+    if (0 != img.has_header)
+    {
+        chars += Tool_WriteRecord(f, '0', 0U, img.header, img.header_len);
+    }
+
+    chars += Tool_WriteRange(f, &img, 0U, img.size, &records);
+
+    chars += Tool_WriteCount(f, records);
+    chars += Tool_WriteRecord(f, '7', img.entry, NULL, 0U);
+    fclose(f);
+
+    /* Read the output back with the target parser: every record must parse
+     * and the count record must match, or the download would be rejected */
+    if (0 != Tool_Simulate(argv[3], &after))
+    {
+        return 1;
+    }
+
+    if (0 != after.count_error)
+    {
+        fprintf(stderr, "%s: count record does not match %u data records\n", argv[3], (unsigned)records);
+        return 1;
+    }
+
+    Tool_PrintSim("input", &before, img.wire_chars);
+    Tool_PrintSim("output", &after, chars);
+    Tool_PrintWire("input", img.wire_chars);
+    Tool_PrintWire("output", chars);
+
+    Tool_FreeImage(&img);
+
+    return 0;
+}
+
+/*============================================================================
+ * RESUME
+ =============================================================================*/
+/**
+ * @brief Read the "MISSING <start> <end>" ranges of a captured progress report
+ *
+ * @return int Number of ranges, -1 when the capture holds no report ("END")
+ */
+static int Tool_ReadMissing(const char *path, uint32_t *start, uint32_t *end, int max)
+{
+    FILE *f;
+    char  line[TOOL_LINE_MAX];
+    char *p;
+    char *e;
+    int   count    = 0;
+    int   have_end = 0;
+
+    f = fopen(path, "r");
+    if (NULL == f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    /* The capture may hold other output around the report, whose lines
+     * start in the first column */
+    while ((0 == have_end) && (NULL != fgets(line, sizeof(line), f)))
+    {
+        if ((0 == strncmp(line, "MISSING ", 8U)) && (count < max))
+        {
+            p            = &line[8];
+            start[count] = (uint32_t)strtoul(p, &e, 0);
+            if (e != p)
+            {
+                p          = e;
+                end[count] = (uint32_t)strtoul(p, &e, 0);
+                count     += (e != p) ? 1 : 0;
+            }
+        }
+        else if (0 == strncmp(line, "END", 3U))
+        {
+            have_end = 1;
+        }
+        else
+        {
+            /* Not part of the report */
+        }
+    }
+
+    fclose(f);
+
+    if (0 == have_end)
+    {
+        fprintf(stderr, "%s: no progress report (MISSING ... END)\n", path);
+        count = -1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief "resume" command: write only the records inside the ranges the
+ *        bootloader reported missing, with a count record for them
+ *
+ * Bootloader_HandleRecord checks S5/S6 against the data records received
+ * in this session, so the count of the original file cannot be reused.
+ */
+static int Tool_CmdResume(int argc, char **argv)
+{
+    static uint32_t start[TOOL_FLASH_SIZE / TOOL_SECTOR_SIZE];
+    static uint32_t end[TOOL_FLASH_SIZE / TOOL_SECTOR_SIZE];
+    Tool_Image_t    img;
+    FILE           *f;
+    uint32_t        chars   = 0U;
+    uint32_t        records = 0U;
+    uint32_t        full    = 0U;
+    uint32_t        bytes   = 0U;
+    int             ranges;
+    int             i;
+
+    if (argc != 5)
+    {
+        fprintf(stderr, "usage: bltool resume <in.srec|in.hex> <progress.txt> <out.srec>\n");
+        return 2;
+    }
+
+    ranges = Tool_ReadMissing(argv[3], start, end, (int)(sizeof(start) / sizeof(start[0])));
+
+    if ((ranges < 0) || (0 != Tool_LoadImage(argv[2], 0U, TOOL_FLASH_SIZE, &img)))
+    {
+        return 1;
+    }
+
+    f = fopen(argv[4], "wb");
+    if (NULL == f)
+    {
+        perror(argv[4]);
+        return 1;
+    }
+
+    if (0 != img.has_header)
+    {
+        chars += Tool_WriteRecord(f, '0', 0U, img.header, img.header_len);
+    }
+
+    for (i = 0; i < ranges; i++)
+    {
+        if ((start[i] >= end[i]) || (end[i] > TOOL_FLASH_SIZE))
+        {
+            fprintf(stderr, "%s: bad range 0x%08X..0x%08X\n", argv[3], (unsigned)start[i], (unsigned)end[i]);
+            fclose(f);
+            return 1;
+        }
+
+        chars += Tool_WriteRange(f, &img, start[i], end[i], &records);
+        bytes += end[i] - start[i];
+    }
+
+    chars += Tool_WriteCount(f, records);
+    chars += Tool_WriteRecord(f, '7', img.entry, NULL, 0U);
+    fclose(f);
+
+    /* Records of the whole image for comparison */
+    (void)Tool_WriteRange(NULL, &img, 0U, img.size, &full);
+
+    printf("missing      %8d ranges %8u bytes\n", ranges, (unsigned)bytes);
+    printf("records      %8u of %u\n", (unsigned)records, (unsigned)full);
+    Tool_PrintWire("full", img.wire_chars);
+    Tool_PrintWire("resume", chars);
+
+    Tool_FreeImage(&img);
+
+    return 0;
+}
+
+/*============================================================================
+ * LOOPBACK
+ =============================================================================*/
+static Tool_Loop_t s_loop;
+
+/**
+ * @brief Uniform random number in [0, 1) (xorshift64*)
+ */
+static double Tool_LoopRandom(void)
+{
+    s_loop.rng ^= s_loop.rng >> 12;
+    s_loop.rng ^= s_loop.rng << 25;
+    s_loop.rng ^= s_loop.rng >> 27;
+
+    return (double)((s_loop.rng * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief Flip every data bit of a character with probability ber
+ */
+static char Tool_LoopCorrupt(char c)
+{
+    uint32_t bit;
+
+    for (bit = 0U; bit < 8U; bit++)
+    {
+        if (Tool_LoopRandom() < s_loop.ber)
+        {
+            c = (char)(c ^ (char)(1U << bit));
+        }
+    }
+
+    return c;
+}
+
+/**
+ * @brief BootProto reply output: queue the line on the reverse link
+ *
+ * Replies leave one after the other once the target handled the frame.
+ */
+void App_SendString(const char *str)
+{
+    Tool_LoopReply_t *r;
+    uint32_t          i;
+
+    if ((s_loop.reply_tail - s_loop.reply_head) < TOOL_LOOP_REPLIES_MAX)
+    {
+        r = &s_loop.replies[s_loop.reply_tail % TOOL_LOOP_REPLIES_MAX];
+
+        for (i = 0U; (i < TOOL_LOOP_REPLY_LEN) && ('\0' != str[i]); i++)
+        {
+            r->text[i] = Tool_LoopCorrupt(str[i]);
+        }
+        r->text[i] = '\0';
+
+        if (s_loop.reverse_free_us < s_loop.now_us)
+        {
+            s_loop.reverse_free_us = s_loop.now_us;
+        }
+        s_loop.reverse_free_us += (double)i * s_loop.char_us;
+        r->at_us = s_loop.reverse_free_us;
+
+        s_loop.reply_tail++;
+    }
+}
+
+/**
+ * @brief BootProto payload consumer: check order and content
+ */
+static int32_t Tool_LoopDeliver(uint8_t *payload, uint32_t len)
+{
+    if ((s_loop.delivered >= s_loop.count) || (len != s_loop.lens[s_loop.delivered]) ||
+        (0 != memcmp(payload, s_loop.lines[s_loop.delivered], len)))
+    {
+        s_loop.undetected++;
+    }
+
+    s_loop.delivered++;
+
+    return BL_OK;
+}
+
+/**
+ * @brief Target side: split the received characters into lines like main.c
+ *        and hand the frames to BootProto
+ */
+static void Tool_LoopReceive(const char *rx, uint32_t len, double at_us)
+{
+    uint32_t start = 0U;
+    uint32_t i;
+
+    s_loop.now_us = (at_us > s_loop.target_free_us) ? at_us : s_loop.target_free_us;
+
+    for (i = 0U; i <= len; i++)
+    {
+        if ((i == len) || ('\r' == rx[i]) || ('\n' == rx[i]))
+        {
+            /* A flipped bit may split a frame or remove its '@': such lines are no frames */
+            if ((i > start) && (BOOTPROTO_FRAME_START == (uint8_t)rx[start]))
+            {
+                BootProto_HandleFrame((const uint8_t *)&rx[start], i - start);
+            }
+            start = i + 1U;
+        }
+    }
+
+    s_loop.target_free_us = s_loop.now_us + s_loop.latency_us;
+}
+
+/**
+ * @brief Build frame idx, send it through the noisy link to the target
+ *
+ * @return double Time the last character left the host
+ */
+static double Tool_LoopSend(uint32_t idx, double t_us)
+{
+    char     frame[BOOTPROTO_MAX_PAYLOAD + 8U];
+    uint8_t  seq = (uint8_t)idx;
+    uint8_t  sum = seq;
+    uint32_t len;
+    uint32_t i;
+
+    for (i = 0U; i < s_loop.lens[idx]; i++)
+    {
+        sum = (uint8_t)(sum + (uint8_t)s_loop.lines[idx][i]);
+    }
+
+    len = (uint32_t)snprintf(frame, sizeof(frame), "@%02X%s%02X\r\n", (unsigned)seq, s_loop.lines[idx],
+                             (unsigned)(uint8_t)~sum);
+
+    for (i = 0U; i < len; i++)
+    {
+        frame[i] = Tool_LoopCorrupt(frame[i]);
+    }
+
+    t_us += (double)len * s_loop.char_us;
+    Tool_LoopReceive(frame, len, t_us);
+
+    return t_us;
+}
+
+/**
+ * @brief Run one transfer with up to window frames unacknowledged
+ *
+ * Retransmits NAKed frames, and the oldest unacknowledged frame when no
+ * reply arrived within TOOL_LOOP_TIMEOUT_US.
+ *
+ * @return int 0 when every payload was delivered once, in order
+ */
+static int Tool_LoopRun(uint32_t window, double *time_us, uint32_t *sent, uint32_t *timeouts)
+{
+    static uint8_t   acked[TOOL_LOOP_FRAMES_MAX];
+    static uint32_t  retx[TOOL_LOOP_FRAMES_MAX];
+    Tool_LoopReply_t *r;
+    uint32_t         retx_count = 0U;
+    uint32_t         base = 0U;
+    uint32_t         next = 0U;
+    uint32_t         idx;
+    uint32_t         guard = 0U;
+    uint8_t          ss;
+    double           t = 0.0;
+
+    memset(acked, 0, sizeof(acked));
+    s_loop.reply_head      = 0U;
+    s_loop.reply_tail      = 0U;
+    s_loop.target_free_us  = 0.0;
+    s_loop.reverse_free_us = 0.0;
+    s_loop.delivered       = 0U;
+    s_loop.undetected      = 0U;
+    *sent     = 0U;
+    *timeouts = 0U;
+
+    BootProto_Init(Tool_LoopDeliver);
+
+    while ((base < s_loop.count) && (guard < (s_loop.count * 100U)))
+    {
+        guard++;
+
+        /* Replies that reached the host by now; damaged ones are ignored */
+        while ((s_loop.reply_head != s_loop.reply_tail) &&
+               (s_loop.replies[s_loop.reply_head % TOOL_LOOP_REPLIES_MAX].at_us <= t))
+        {
+            r = &s_loop.replies[s_loop.reply_head % TOOL_LOOP_REPLIES_MAX];
+            s_loop.reply_head++;
+
+            if ((0 != strcmp(&r->text[3], "\r\n")) ||
+                (SREC_STATUS_OK != Srec_HexToByte((uint8_t)r->text[1], (uint8_t)r->text[2], &ss)))
+            {
+                continue;
+            }
+
+            for (idx = base; (idx < next) && ((uint8_t)idx != ss); idx++)
+            {
+                /* find the frame in flight with this sequence number */
+            }
+
+            if (idx < next)
+            {
+                if ('A' == r->text[0])
+                {
+                    acked[idx] = 1U;
+                }
+                else if (('N' == r->text[0]) && (0U == acked[idx]))
+                {
+                    retx[retx_count++] = idx;
+                }
+                else
+                {
+                    /* 'E' never comes: the consumer accepts every payload */
+                }
+            }
+        }
+
+        while ((base < next) && (0U != acked[base]))
+        {
+            base++;
+        }
+
+        /* NAKed frames first, then new ones while the window has room */
+        while ((0U != retx_count) && ((retx[0] < base) || (0U != acked[retx[0]])))
+        {
+            retx_count--;
+            memmove(&retx[0], &retx[1], retx_count * sizeof(retx[0]));
+        }
+
+        if (0U != retx_count)
+        {
+            idx = retx[0];
+            retx_count--;
+            memmove(&retx[0], &retx[1], retx_count * sizeof(retx[0]));
+        }
+        else if ((next < s_loop.count) && (next < (base + window)))
+        {
+            idx = next;
+            next++;
+        }
+        else if (s_loop.reply_head != s_loop.reply_tail)
+        {
+            /* Window full: wait for the next reply */
+            t = s_loop.replies[s_loop.reply_head % TOOL_LOOP_REPLIES_MAX].at_us;
+            continue;
+        }
+        else if (base < s_loop.count)
+        {
+            t += TOOL_LOOP_TIMEOUT_US;
+            (*timeouts)++;
+            idx = base;
+        }
+        else
+        {
+            break;
+        }
+
+        t = Tool_LoopSend(idx, t);
+        (*sent)++;
+    }
+
+    *time_us = t;
+
+    return ((base == s_loop.count) && (s_loop.delivered == s_loop.count) && (0U == s_loop.undetected)) ? 0 : -1;
+}
+
+/**
+ * @brief "loopback" command: send a file through BootProto over a simulated
+ *        noisy link and report the effective throughput per window size
+ */
+static int Tool_CmdLoopback(int argc, char **argv)
+{
+    static char     text[TOOL_LOOP_FRAMES_MAX][BOOTPROTO_MAX_PAYLOAD];
+    static char    *lines[TOOL_LOOP_FRAMES_MAX];
+    static uint32_t lens[TOOL_LOOP_FRAMES_MAX];
+    FILE           *f;
+    uint32_t        count = 0U;
+    uint32_t        chars = 0U;
+    uint32_t        window;
+    uint32_t        sent;
+    uint32_t        timeouts;
+    uint32_t        len;
+    double          time_us;
+    double          cps;
+    int             ok;
+    int             result = 0;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: bltool loopback <file> [ber] [latency_us] [seed]\n");
+        return 2;
+    }
+
+    f = fopen(argv[2], "r");
+    if (NULL == f)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+
+    while ((count < TOOL_LOOP_FRAMES_MAX) && (NULL != fgets(text[count], BOOTPROTO_MAX_PAYLOAD, f)))
+    {
+        len = (uint32_t)strcspn(text[count], "\r\n");
+        text[count][len] = '\0';
+
+        if (0U != len)
+        {
+            lines[count] = text[count];
+            lens[count]  = len;
+            chars       += len + 2U;
+            count++;
+        }
+    }
+    fclose(f);
+
+    memset(&s_loop, 0, sizeof(s_loop));
+    s_loop.lines      = lines;
+    s_loop.lens       = lens;
+    s_loop.count      = count;
+    s_loop.ber        = (argc >= 4) ? strtod(argv[3], NULL) : TOOL_LOOP_BER;
+    s_loop.latency_us = (argc >= 5) ? strtod(argv[4], NULL) : TOOL_LOOP_LATENCY_US;
+    s_loop.char_us    = ((double)TOOL_BITS_PER_CHAR * 1e6) / (double)TOOL_BAUDRATE;
+
+    printf("%s: %u frames, %u chars, BER %g, %.0f us per frame on target, %lu baud\n", argv[2],
+           (unsigned)count, (unsigned)chars, s_loop.ber, s_loop.latency_us, (unsigned long)TOOL_BAUDRATE);
+    printf("%6s %8s %8s %8s %10s %10s %9s %6s\n", "window", "sent", "retx", "timeouts", "undetected",
+           "time_s", "chars/s", "link%");
+
+    for (window = 1U; window <= BOOTPROTO_WINDOW_SIZE; window++)
+    {
+        /* Same error pattern for every window size */
+        s_loop.rng = (argc >= 6) ? strtoull(argv[5], NULL, 0) : 0x2545F4914F6CDD1DULL;
+        if (0ULL == s_loop.rng)
+        {
+            s_loop.rng = 1ULL;
+        }
+
+        ok  = Tool_LoopRun(window, &time_us, &sent, &timeouts);
+        cps = (time_us > 0.0) ? (((double)chars * 1e6) / time_us) : 0.0;
+
+        printf("%6u %8u %8u %8u %10u %10.2f %9.1f %5.1f%% %s\n", (unsigned)window, (unsigned)sent,
+               (unsigned)(sent - count), (unsigned)timeouts, (unsigned)s_loop.undetected, time_us / 1e6,
+               cps, (cps * 100.0 * s_loop.char_us) / 1e6, (0 == ok) ? "ok" : "FAIL");
+
+        result |= ok;
+    }
+
+    return (0 == result) ? 0 : 1;
+}
+
+/*============================================================================
+ * BENCH
+ =============================================================================*/
+/**
+ * @brief Monotonic time in ns
+ */
+static uint64_t Tool_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Compare an in-place view with a record from the copying parser
+ *
+ * @return int 1 when both hold the same record
+ */
+static int Tool_SameRecord(Srec_Status_t st_rec, const srec_record_t *rec, Srec_Status_t st_view, const srec_view_t *view)
+{
+    int same = (st_rec == st_view);
+
+    if (same && (SREC_STATUS_OK == st_rec))
+    {
+        same = (rec->type == view->type) && (rec->address == view->address) &&
+               (rec->data_len == view->data_len) &&
+               (0 == memcmp(rec->data, view->data, rec->data_len));
+    }
+
+    return same;
+}
+
+/**
+ * @brief Parser timed by Tool_BenchRun
+ */
+typedef enum
+{
+    TOOL_BENCH_SREC_COPY = 0,     /* Srec_ParseSrecLine into a record */
+    TOOL_BENCH_SREC_VIEW,         /* Srec_ParseSrecLineInPlace */
+    TOOL_BENCH_IHEX_VIEW          /* Ihex_ParseLine */
+} Tool_BenchKind_t;
+
+static char     s_bench_lines[65536][TOOL_LINE_MAX];
+static uint32_t s_bench_sizes[65536];
+
+/**
+ * @brief Time one parser over a subset of the loaded lines
+ *
+ * Every pass copies each line into a work buffer first, like a queue pop
+ * does, whichever parser runs; only the parser call differs.
+ *
+ * @return uint64_t ns per pass over the subset
+ */
+static uint64_t Tool_BenchRun(Tool_BenchKind_t kind, const uint32_t *idx, uint32_t n)
+{
+    char           work[TOOL_LINE_MAX];
+    srec_record_t  rec;
+    srec_view_t    view;
+    ihex_context_t ihex;
+    uint64_t       passes = 0U;
+    uint64_t       t0;
+    uint64_t       ns;
+    uint32_t       i;
+    uint32_t       k;
+
+    t0 = Tool_NowNs();
+    do
+    {
+        Ihex_Init(&ihex);
+
+        for (i = 0U; i < n; i++)
+        {
+            k = idx[i];
+            memcpy(work, s_bench_lines[k], s_bench_sizes[k]);
+
+            switch (kind)
+            {
+                case TOOL_BENCH_SREC_COPY:
+                    (void)Srec_ParseSrecLine((const uint8_t *)work, &rec);
+                    break;
+                case TOOL_BENCH_SREC_VIEW:
+                    (void)Srec_ParseSrecLineInPlace((uint8_t *)work, s_bench_sizes[k], &view);
+                    break;
+                default:
+                    (void)Ihex_ParseLine(&ihex, (uint8_t *)work, s_bench_sizes[k], &view);
+                    break;
+            }
+        }
+        passes++;
+        ns = Tool_NowNs() - t0;
+    } while (ns < TOOL_BENCH_MIN_NS);
+
+    return ns / passes;
+}
+
+/**
+ * @brief Print one timing line
+ */
+static void Tool_BenchPrint(const char *what, uint64_t ns, uint32_t lines, uint64_t chars)
+{
+    printf("  %-13s %8.1f ns/line  %7.1f MB/s\n", what,
+           (double)ns / (double)lines, ((double)chars * 1000.0) / (double)ns);
+}
+
+/**
+ * @brief "bench" command: parse every line of each file repeatedly
+ *
+ * SREC lines are parsed both by Srec_ParseSrecLine (copy into a record)
+ * and in place over the same lines; the results must match bit for bit.
+ * Intel HEX has the in-place parser only.
+ */
+static int Tool_CmdBench(int argc, char **argv)
+{
+    static uint32_t srec_idx[65536];
+    static uint32_t ihex_idx[65536];
+    char            work[TOOL_LINE_MAX];
+    srec_record_t   rec;
+    srec_view_t     view;
+    Srec_Status_t   st;
+    FILE           *f;
+    uint32_t        count;
+    uint32_t        srec_n;
+    uint32_t        ihex_n;
+    uint32_t        i;
+    uint32_t        mismatches;
+    uint32_t        errors;
+    uint64_t        srec_chars;
+    uint64_t        ihex_chars;
+    int             a;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: bltool bench <file> [file...]\n");
+        return 2;
+    }
+
+    for (a = 2; a < argc; a++)
+    {
+        f = fopen(argv[a], "r");
+        if (NULL == f)
+        {
+            perror(argv[a]);
+            return 1;
+        }
+
+        count      = 0U;
+        srec_n     = 0U;
+        ihex_n     = 0U;
+        srec_chars = 0U;
+        ihex_chars = 0U;
+        while ((count < 65536U) && (NULL != fgets(s_bench_lines[count], TOOL_LINE_MAX, f)))
+        {
+            s_bench_sizes[count] = (uint32_t)strlen(s_bench_lines[count]) + 1U;
+
+            if ('S' == s_bench_lines[count][0])
+            {
+                srec_idx[srec_n++] = count;
+                srec_chars        += s_bench_sizes[count] - 1U;
+            }
+            else if (IHEX_START_CODE == (uint8_t)s_bench_lines[count][0])
+            {
+                ihex_idx[ihex_n++] = count;
+                ihex_chars        += s_bench_sizes[count] - 1U;
+            }
+            else
+            {
+                /* Neither parser sees it on target */
+            }
+            count++;
+        }
+        fclose(f);
+
+        /* Validate the in-place parser against the copying one */
+        mismatches = 0U;
+        errors     = 0U;
+        for (i = 0U; i < srec_n; i++)
+        {
+            memcpy(work, s_bench_lines[srec_idx[i]], s_bench_sizes[srec_idx[i]]);
+            st = Srec_ParseSrecLine((const uint8_t *)s_bench_lines[srec_idx[i]], &rec);
+            mismatches += Tool_SameRecord(st, &rec, Srec_ParseSrecLineInPlace((uint8_t *)work, s_bench_sizes[srec_idx[i]], &view), &view) ? 0U : 1U;
+            errors     += (SREC_STATUS_OK != st) ? 1U : 0U;
+        }
+
+        printf("%s: %u SREC lines, %u Intel HEX lines, %u SREC errors, %u in-place mismatches\n", argv[a],
+               (unsigned)srec_n, (unsigned)ihex_n, (unsigned)errors, (unsigned)mismatches);
+
+        if (0U != srec_n)
+        {
+            Tool_BenchPrint("srec copy", Tool_BenchRun(TOOL_BENCH_SREC_COPY, srec_idx, srec_n), srec_n, srec_chars);
+            Tool_BenchPrint("srec in place", Tool_BenchRun(TOOL_BENCH_SREC_VIEW, srec_idx, srec_n), srec_n, srec_chars);
+        }
+
+        if (0U != ihex_n)
+        {
+            Tool_BenchPrint("ihex in place", Tool_BenchRun(TOOL_BENCH_IHEX_VIEW, ihex_idx, ihex_n), ihex_n, ihex_chars);
+        }
+    }
+
+    return 0;
+}
+
+/*============================================================================
+ * TRACE
+ =============================================================================*/
+/**
+ * @brief Name of a trace event ID
+ */
+static const char *Tool_TraceName(uint8_t id)
+{
+    const char *name = "?";
+
+    switch (id)
+    {
+        case TRACE_ID_UART_IRQ:      name = "UART_IRQ";      break;
+        case TRACE_ID_PARSE_BEGIN:   name = "PARSE_BEGIN";   break;
+        case TRACE_ID_PARSE_END:     name = "PARSE_END";     break;
+        case TRACE_ID_FLUSH_BEGIN:   name = "FLUSH_BEGIN";   break;
+        case TRACE_ID_FLUSH_END:     name = "FLUSH_END";     break;
+        case TRACE_ID_ERASE_BEGIN:   name = "ERASE_BEGIN";   break;
+        case TRACE_ID_ERASE_END:     name = "ERASE_END";     break;
+        case TRACE_ID_PROGRAM_BEGIN: name = "PROGRAM_BEGIN"; break;
+        case TRACE_ID_PROGRAM_END:   name = "PROGRAM_END";   break;
+        default:                                             break;
+    }
+
+    return name;
+}
+
+/**
+ * @brief "trace" command: decode a captured "#TRACE" dump
+ *
+ * Timestamps are 32-bit cycle counts; consecutive events are assumed less
+ * than one wrap (~53 s at 80 MHz) apart. A *_END event is matched with the
+ * last *_BEGIN of the same kind to give the duration of the operation.
+ */
+static int Tool_CmdTrace(int argc, char **argv)
+{
+    static uint8_t buf[TOOL_TRACE_CAPTURE_MAX];
+    double         cpu_hz = TOOL_TRACE_CPU_HZ;
+    double         kind_us[TOOL_TRACE_KINDS];
+    uint32_t       kind_count[TOOL_TRACE_KINDS];
+    uint64_t       begin_at[TOOL_TRACE_KINDS];
+    uint8_t        begin_seen[TOOL_TRACE_KINDS];
+    uint64_t       now = 0U;
+    uint32_t       prev_ts = 0U;
+    uint32_t       count;
+    uint32_t       ts;
+    uint32_t       info;
+    uint32_t       arg;
+    uint32_t       i;
+    uint8_t        id;
+    uint8_t        kind;
+    const uint8_t *ev;
+    char          *hdr;
+    char          *end;
+    size_t         len;
+    FILE          *f;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: bltool trace <capture> [cpu_hz]\n");
+        return 2;
+    }
+
+    if (argc >= 4)
+    {
+        cpu_hz = strtod(argv[3], NULL);
+    }
+
+    f = fopen(argv[2], "rb");
+    if (NULL == f)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    len = fread(buf, 1U, sizeof(buf) - 1U, f);
+    fclose(f);
+    buf[len] = 0U;
+
+    /* The capture may hold other output before the dump */
+    hdr = NULL;
+    for (i = 0U; (i + 6U) <= len; i++)
+    {
+        if (0 == memcmp(&buf[i], "TRACE ", 6U))
+        {
+            hdr = (char *)&buf[i];
+        }
+    }
+
+    if (NULL == hdr)
+    {
+        fprintf(stderr, "%s: no TRACE header\n", argv[2]);
+        return 1;
+    }
+
+    /* Trace_Dump sends exactly "\r\n" after the count; the events are binary
+     * and may themselves start with CR or LF */
+    count = (uint32_t)strtoul(hdr + 6, &end, 16);
+    if (('\r' != end[0]) || ('\n' != end[1]))
+    {
+        fprintf(stderr, "%s: TRACE header not followed by CR LF\n", argv[2]);
+        return 1;
+    }
+    end += 2;
+    ev = (const uint8_t *)end;
+
+    if ((size_t)((ev - buf) + ((size_t)count * sizeof(Trace_Event_t))) > len)
+    {
+        fprintf(stderr, "%s: dump truncated (%u events announced)\n", argv[2], (unsigned)count);
+        return 1;
+    }
+
+    memset(kind_us, 0, sizeof(kind_us));
+    memset(kind_count, 0, sizeof(kind_count));
+    memset(begin_at, 0, sizeof(begin_at));
+    memset(begin_seen, 0, sizeof(begin_seen));
+
+    printf("%12s %10s  %-14s %8s %10s\n", "time_us", "delta_us", "event", "arg", "dur_us");
+
+    for (i = 0U; i < count; i++, ev += sizeof(Trace_Event_t))
+    {
+        ts   = (uint32_t)ev[0] | ((uint32_t)ev[1] << 8U) | ((uint32_t)ev[2] << 16U) | ((uint32_t)ev[3] << 24U);
+        info = (uint32_t)ev[4] | ((uint32_t)ev[5] << 8U) | ((uint32_t)ev[6] << 16U) | ((uint32_t)ev[7] << 24U);
+        id   = (uint8_t)(info >> TRACE_ID_SHIFT);
+        arg  = info & TRACE_ARG_MASK;
+        kind = (uint8_t)((id >> 4U) % TOOL_TRACE_KINDS);
+
+        if (0U != i)
+        {
+            now += (uint32_t)(ts - prev_ts);
+        }
+
+        printf("%12.1f %10.1f  %-14s %08X", ((double)now * 1e6) / cpu_hz,
+               (0U != i) ? (((double)(uint32_t)(ts - prev_ts) * 1e6) / cpu_hz) : 0.0,
+               Tool_TraceName(id), (unsigned)arg);
+        prev_ts = ts;
+
+        if (TRACE_ID_UART_IRQ == id)
+        {
+            kind_count[kind]++;
+        }
+        else if (0U == (id & 1U))
+        {
+            begin_at[kind]   = now;
+            begin_seen[kind] = 1U;
+        }
+        else if (0U != begin_seen[kind])
+        {
+            double dur = ((double)(now - begin_at[kind]) * 1e6) / cpu_hz;
+
+            printf(" %10.1f", dur);
+            kind_us[kind] += dur;
+            kind_count[kind]++;
+            begin_seen[kind] = 0U;
+        }
+        else
+        {
+            /* BEGIN fell out of the ring */
+        }
+
+        printf("\n");
+    }
+
+    printf("\n%u events over %.1f us\n", (unsigned)count, ((double)now * 1e6) / cpu_hz);
+    printf("  UART_IRQ %8u\n", (unsigned)kind_count[TRACE_ID_UART_IRQ >> 4U]);
+    for (kind = 1U; kind < TOOL_TRACE_KINDS; kind++)
+    {
+        if (0U != kind_count[kind])
+        {
+            printf("  %-8.*s %8u x  total %10.1f us  mean %8.1f us\n",
+                   (int)(strlen(Tool_TraceName((uint8_t)(kind << 4U))) - 6U),
+                   Tool_TraceName((uint8_t)(kind << 4U)), (unsigned)kind_count[kind],
+                   kind_us[kind], kind_us[kind] / (double)kind_count[kind]);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Bench_Print_t to stdout
+ */
+static void Tool_Print(const char *str)
+{
+    fputs(str, stdout);
+}
+
+/*============================================================================
+ * MAIN
+ =============================================================================*/
+int main(int argc, char **argv)
+{
+    int result = 2;
+
+    if ((argc >= 2) && (0 == strcmp(argv[1], "delta")))
+    {
+        result = Tool_CmdDelta(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "compress")))
+    {
+        result = Tool_CmdCompress(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "optimize")))
+    {
+        result = Tool_CmdOptimize(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "resume")))
+    {
+        result = Tool_CmdResume(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "loopback")))
+    {
+        result = Tool_CmdLoopback(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "bench")))
+    {
+        result = Tool_CmdBench(argc, argv);
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "microbench")))
+    {
+        BootBench_RunAll(Tool_Print);
+        result = 0;
+    }
+    else if ((argc >= 2) && (0 == strcmp(argv[1], "trace")))
+    {
+        result = Tool_CmdTrace(argc, argv);
+    }
+    else
+    {
+        fprintf(stderr, "usage: bltool delta|compress|optimize|resume|loopback|bench|microbench|trace ...\n");
+    }
+
+    return result;
+}
@@ -0,0 +1,537 @@
+/**
+ * @file fuzz_records.c
+ * @author Dung Van Pham (dungpv00@gmail.com)
+ * @brief Fuzz and property tests for the record parsers and the line queue
+ * @version 0.1
+ * @date 2026-03-02
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build (host, not part of the S32DS project):
+ *   libFuzzer / AFL++ (LLVMFuzzerTestOneInput):
+ *     clang -g -O1 -fsanitize=fuzzer,address,undefined -DTRACE_ENABLE=0 -o fuzz_records \
+ *         fuzz_records.c ../src/src/srec.c ../src/src/ihex.c ../src/src/Queue.c
+ *     ./fuzz_records corpus/
+ *   Standalone random driver (any C compiler):
+ *     gcc -g -O1 -fsanitize=address,undefined -DFUZZ_STANDALONE -DTRACE_ENABLE=0 -o fuzz_records \
+ *         fuzz_records.c ../src/src/srec.c ../src/src/ihex.c ../src/src/Queue.c
+ *     ./fuzz_records [iterations] [seed]
+ *
+ * Every input is checked four ways:
+ *   1. Srec_ParseSrecLineInPlace / Ihex_ParseLine on a heap copy of exactly
+ *      the input length (no NUL): the sanitizer catches any read past
+ *      max_len, a successful view must point inside the buffer.
+ *   2. Srec_ParseSrecLineInPlace against Srec_ParseSrecLine (reference) on
+ *      the NUL-terminated input: same status, same record.
+ *   3. The input as a script of Queue_Srec_Push/Pop calls, against a
+ *      model FIFO: FULL, PARAM, EMPTY and TRUNCATED exactly when expected,
+ *      a pop never writes past out_line_max.
+ *   4. The input as a UART byte stream through Queue_Line_PutChar, the
+ *      line assembler of main.c: every pushed line holds exactly the
+ *      characters since the previous line end, only overlong lines are
+ *      dropped, a full queue is drained through the callback, and every
+ *      popped line goes through the per-line format detection.
+ * A failed property aborts, so both fuzzers record the input.
+ */
+/*============================================================================
+ * INCLUDE
+ =============================================================================*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/src/incl/ihex.h"
+#include "../src/src/incl/Queue.h"
+#include "../src/src/incl/srec.h"
+
+/*============================================================================
+ * DEFINES
+ =============================================================================*/
+#define FUZZ_MAX_INPUT             (1024U)         /* standalone driver */
+#define FUZZ_ITERATIONS            (1000000UL)
+
+#define FUZZ_CHECK(cond)           do { if (!(cond)) { Fuzz_Fail(#cond, __LINE__); } } while (0)
+
+/*============================================================================
+ * TYPES
+ =============================================================================*/
+/**
+ * @brief Counters of the standalone driver
+ */
+typedef struct
+{
+    uint64_t srec_ok;
+    uint64_t ihex_ok;
+    uint64_t truncated;
+    uint64_t lines;
+} Fuzz_Stats_t;
+
+/*============================================================================
+ * VARIABLES
+ =============================================================================*/
+static Fuzz_Stats_t   s_stats;
+static ihex_context_t s_ihex;
+
+/* Valid lines the standalone driver mutates */
+static const char * const s_seeds[] =
+{
+    "S00F000068656C6C6F202020202000003C",
+    "S1130000285F245F2212226A000424290008237C2A",
+    "S2140A0000202122232425262728292A2B2C2D2E2F94",
+    "S3250000A000202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F4A",
+    "S5030003F9",
+    "S604010000FA",
+    "S7050000A0005A",
+    "S804000000FB",
+    "S9030000FC",
+    ":020000040000FA",
+    ":10A000002021222324252627282929AB2C2D2E2F2C",
+    ":0400000500000AA14C",
+    ":00000001FF",
+    "#PROGRESS",
+};
+
+/*============================================================================
+ * LOCAL FUNCTIONS
+ =============================================================================*/
+/**
+ * @brief Report a failed property and abort
+ */
+static void Fuzz_Fail(const char *what, int line)
+{
+    fprintf(stderr, "fuzz_records.c:%d: property failed: %s\n", line, what);
+    abort();
+}
+
+/**
+ * @brief Check a successful view against the buffer it was decoded in
+ */
+static void Fuzz_CheckView(const srec_view_t *view, const uint8_t *buf, uint32_t len)
+{
+    FUZZ_CHECK(view->data_len <= SREC_MAX_DATA_BYTES);
+
+    if (0U != view->data_len)
+    {
+        FUZZ_CHECK((view->data >= buf) && ((view->data + view->data_len) <= (buf + len)));
+    }
+}
+
+/**
+ * @brief Property 1: bounded parsers read nothing past max_len
+ */
+static void Fuzz_Bounded(const uint8_t *data, uint32_t size)
+{
+    ihex_context_t ihex;
+    srec_view_t    view;
+    uint8_t       *buf;
+
+    /* Exactly size bytes: one byte more is a heap overflow */
+    buf = (uint8_t *)malloc((0U != size) ? size : 1U);
+    if (NULL == buf)
+    {
+        return;
+    }
+
+    memcpy(buf, data, size);
+    if (SREC_STATUS_OK == Srec_ParseSrecLineInPlace(buf, size, &view))
+    {
+        Fuzz_CheckView(&view, buf, size);
+        s_stats.srec_ok++;
+    }
+
+    memcpy(buf, data, size);
+    Ihex_Init(&ihex);
+    if (SREC_STATUS_OK == Ihex_ParseLine(&ihex, buf, size, &view))
+    {
+        Fuzz_CheckView(&view, buf, size);
+        s_stats.ihex_ok++;
+    }
+
+    free(buf);
+}
+
+/**
+ * @brief Property 2: in-place SREC parser matches the copying reference
+ */
+static void Fuzz_SrecReference(const uint8_t *data, uint32_t size)
+{
+    static uint8_t line[FUZZ_MAX_INPUT + 1U];
+    static uint8_t work[FUZZ_MAX_INPUT + 1U];
+    srec_record_t  rec;
+    srec_view_t    view;
+    Srec_Status_t  st_rec;
+    Srec_Status_t  st_view;
+    uint32_t       n = (size < FUZZ_MAX_INPUT) ? size : FUZZ_MAX_INPUT;
+
+    /* The reference reads up to the NUL */
+    memcpy(line, data, n);
+    line[n] = 0U;
+    memcpy(work, line, n + 1U);
+
+    st_rec  = Srec_ParseSrecLine(line, &rec);
+    st_view = Srec_ParseSrecLineInPlace(work, n + 1U, &view);
+
+    FUZZ_CHECK(st_rec == st_view);
+
+    if (SREC_STATUS_OK == st_rec)
+    {
+        FUZZ_CHECK(rec.type == view.type);
+        FUZZ_CHECK(rec.address == view.address);
+        FUZZ_CHECK(rec.data_len == view.data_len);
+        FUZZ_CHECK(0 == memcmp(rec.data, view.data, rec.data_len));
+    }
+}
+
+/**
+ * @brief Property 3: queue against a model FIFO
+ *
+ * Script, repeated while input remains:
+ *   op byte, bit 0 = 0 : push, length from the next byte (0..255, 256 for 0xFF)
+ *                        taken from the input that follows
+ *   op byte, bit 0 = 1 : pop into a heap buffer of (op >> 1) + 1 bytes
+ */
+static void Fuzz_Queue(const uint8_t *data, uint32_t size)
+{
+    static uint8_t  model[QUEUE_MAX_ELEMENTS][QUEUE_MAX_LINE_LENGTH + 8U];
+    static uint32_t model_len[QUEUE_MAX_ELEMENTS];
+    Queue_Srec_t    q;
+    Queue_Status_t  st;
+    uint32_t        head  = 0U;
+    uint32_t        count = 0U;
+    uint32_t        pos   = 0U;
+    uint32_t        len;
+    uint32_t        max;
+    uint32_t        out_len;
+    uint8_t        *out;
+    uint8_t         op;
+
+    FUZZ_CHECK(QUEUE_STATUS_OK == Queue_Srec_Init(&q));
+
+    while (pos < size)
+    {
+        op = data[pos++];
+
+        if (0U == (op & 1U))
+        {
+            len = (pos < size) ? data[pos++] : 0U;
+            len = (0xFFU == len) ? (QUEUE_MAX_LINE_LENGTH + 1U) : len;
+            if (len > (size - pos))
+            {
+                len = size - pos;
+            }
+
+            st = Queue_Srec_Push(&q, &data[pos], len);
+
+            if ((0U == len) || (len > QUEUE_MAX_LINE_LENGTH))
+            {
+                FUZZ_CHECK(QUEUE_STATUS_PARAM == st);
+            }
+            else if (QUEUE_MAX_ELEMENTS == count)
+            {
+                FUZZ_CHECK(QUEUE_STATUS_FULL == st);
+            }
+            else
+            {
+                FUZZ_CHECK(QUEUE_STATUS_OK == st);
+                memcpy(model[(head + count) % QUEUE_MAX_ELEMENTS], &data[pos], len);
+                model_len[(head + count) % QUEUE_MAX_ELEMENTS] = len;
+                count++;
+            }
+
+            pos += len;
+        }
+        else
+        {
+            /* Exactly max bytes: a write past out_line_max is a heap overflow */
+            max = ((uint32_t)op >> 1U) + 1U;
+            out = (uint8_t *)malloc(max);
+            if (NULL == out)
+            {
+                return;
+            }
+
+            st = Queue_Srec_Pop(&q, out, max, &out_len);
+
+            if (0U == count)
+            {
+                FUZZ_CHECK(QUEUE_STATUS_EMPTY == st);
+                FUZZ_CHECK(0U == out_len);
+            }
+            else
+            {
+                len = model_len[head];
+
+                FUZZ_CHECK(((len > max) ? QUEUE_STATUS_TRUNCATED : QUEUE_STATUS_OK) == st);
+                FUZZ_CHECK(((len > max) ? max : len) == out_len);
+                FUZZ_CHECK(0 == memcmp(out, model[head], out_len));
+
+                s_stats.truncated += (QUEUE_STATUS_TRUNCATED == st) ? 1U : 0U;
+                head = (head + 1U) % QUEUE_MAX_ELEMENTS;
+                count--;
+            }
+
+            free(out);
+        }
+    }
+}
+
+/**
+ * @brief Queue drain callback: handle one line like Boot_ProcessOneQueuedLine
+ *
+ * @return uint8_t 1: a line was popped, 0: queue empty
+ */
+static uint8_t Fuzz_StreamLine(Queue_Srec_t *q)
+{
+    uint8_t        line[QUEUE_MAX_LINE_LENGTH + 1U];
+    uint32_t       line_len;
+    srec_view_t    view;
+    Queue_Status_t qst;
+
+    qst = Queue_Srec_Pop(q, line, QUEUE_MAX_LINE_LENGTH, &line_len);
+
+    /* The assembly buffer is smaller than a queue element: never cut */
+    FUZZ_CHECK(QUEUE_STATUS_TRUNCATED != qst);
+
+    if (QUEUE_STATUS_OK == qst)
+    {
+        FUZZ_CHECK((0U != line_len) && (line_len < QUEUE_LINE_BUFFER_SIZE));
+        line[line_len] = '\0';
+        s_stats.lines++;
+
+        if (IHEX_START_CODE == line[0])
+        {
+            if (SREC_STATUS_OK == Ihex_ParseLine(&s_ihex, line, line_len, &view))
+            {
+                Fuzz_CheckView(&view, line, line_len);
+            }
+        }
+        else if ((uint8_t)'#' != line[0])
+        {
+            if (SREC_STATUS_OK == Srec_ParseSrecLineInPlace(line, line_len, &view))
+            {
+                Fuzz_CheckView(&view, line, line_len);
+            }
+        }
+        else
+        {
+            /* Bootloader command */
+        }
+    }
+
+    return (QUEUE_STATUS_OK == qst) ? 1U : 0U;
+}
+
+/**
+ * @brief Property 4: the input as received UART bytes through Queue_Line_PutChar
+ *
+ * The queue is drained after every (QUEUE_MAX_ELEMENTS + 1)th line only, so
+ * pushes also hit a full queue and drain through the callback.
+ */
+static void Fuzz_Stream(const uint8_t *data, uint32_t size)
+{
+    Queue_Srec_t           q;
+    Queue_Line_t           line;
+    Queue_LineEvent_t      event;
+    const Queue_Element_t *newest;
+    uint32_t               start  = 0U;     /* first character of the current line */
+    uint32_t               pushed = 0U;
+    uint32_t               i;
+    uint8_t                c;
+
+    (void)Queue_Srec_Init(&q);
+    (void)Queue_Line_Init(&line);
+    Ihex_Init(&s_ihex);
+
+    for (i = 0U; i < size; i++)
+    {
+        c     = data[i];
+        event = Queue_Line_PutChar(&line, &q, c, Fuzz_StreamLine);
+
+        if (QUEUE_LINE_PUSHED == event)
+        {
+            newest = &q.elements[(q.tail + QUEUE_MAX_ELEMENTS - 1U) % QUEUE_MAX_ELEMENTS];
+            FUZZ_CHECK((i - start) < QUEUE_LINE_BUFFER_SIZE);
+            FUZZ_CHECK(newest->length == (i - start));
+            FUZZ_CHECK(0 == memcmp(newest->data, &data[start], newest->length));
+
+            pushed++;
+            if (0U == (pushed % (QUEUE_MAX_ELEMENTS + 1U)))
+            {
+                while (0U != Fuzz_StreamLine(&q))
+                {
+                    /* Drain queue */
+                }
+            }
+        }
+        else if (QUEUE_LINE_DROPPED == event)
+        {
+            FUZZ_CHECK((i - start) >= QUEUE_LINE_BUFFER_SIZE);
+        }
+        else
+        {
+            /* Only an empty line ends without an event */
+            FUZZ_CHECK(((c != (uint8_t)'\r') && (c != (uint8_t)'\n')) || (i == start));
+        }
+
+        if ((c == (uint8_t)'\r') || (c == (uint8_t)'\n'))
+        {
+            start = i + 1U;
+        }
+    }
+
+    while (0U != Fuzz_StreamLine(&q))
+    {
+        /* Drain queue */
+    }
+}
+
+/*============================================================================
+ * FUZZ ENTRY
+ =============================================================================*/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size <= FUZZ_MAX_INPUT)
+    {
+        Fuzz_Bounded(data, (uint32_t)size);
+        Fuzz_SrecReference(data, (uint32_t)size);
+        Fuzz_Queue(data, (uint32_t)size);
+        Fuzz_Stream(data, (uint32_t)size);
+    }
+
+    return 0;
+}
+
+#if defined(FUZZ_STANDALONE)
+/*============================================================================
+ * STANDALONE DRIVER
+ =============================================================================*/
+static uint64_t s_rng = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Random number (xorshift64*)
+ */
+static uint32_t Fuzz_Random(void)
+{
+    s_rng ^= s_rng >> 12;
+    s_rng ^= s_rng << 25;
+    s_rng ^= s_rng >> 27;
+
+    return (uint32_t)((s_rng * 2685821657736338717ULL) >> 32);
+}
+
+/**
+ * @brief Build one input: seed lines, then random mutations
+ *
+ * @return uint32_t Input length
+ */
+static uint32_t Fuzz_Generate(uint8_t *buf)
+{
+    static const char alphabet[] = "0123456789ABCDEFabcdefS:#@\r\n \x00\xFF";
+    uint32_t          len = 0U;
+    uint32_t          n;
+    uint32_t          k;
+    uint32_t          pos;
+    const char       *seed;
+
+    /* One to eight lines */
+    for (n = (Fuzz_Random() % 8U) + 1U; (n > 0U) && (len < FUZZ_MAX_INPUT); n--)
+    {
+        seed = s_seeds[Fuzz_Random() % (sizeof(s_seeds) / sizeof(s_seeds[0]))];
+        k    = (uint32_t)strlen(seed);
+        if ((len + k + 2U) > FUZZ_MAX_INPUT)
+        {
+            break;
+        }
+
+        memcpy(&buf[len], seed, k);
+        len += k;
+        buf[len++] = '\r';
+        buf[len++] = '\n';
+    }
+
+    for (n = Fuzz_Random() % 8U; n > 0U; n--)
+    {
+        pos = (0U != len) ? (Fuzz_Random() % len) : 0U;
+
+        switch (Fuzz_Random() % 6U)
+        {
+            case 0U:    /* bit flip */
+                buf[pos] ^= (uint8_t)(1U << (Fuzz_Random() % 8U));
+                break;
+            case 1U:    /* character likely to matter */
+                buf[pos] = (uint8_t)alphabet[Fuzz_Random() % (sizeof(alphabet) - 1U)];
+                break;
+            case 2U:    /* random byte */
+                buf[pos] = (uint8_t)Fuzz_Random();
+                break;
+            case 3U:    /* truncate */
+                len = pos;
+                break;
+            case 4U:    /* long run without line end, inserted at pos */
+                k = Fuzz_Random() % 400U;
+                if (k > (FUZZ_MAX_INPUT - len))
+                {
+                    k = FUZZ_MAX_INPUT - len;
+                }
+                memmove(&buf[pos + k], &buf[pos], len - pos);
+                len += k;
+                while (k > 0U)
+                {
+                    k--;
+                    buf[pos + k] = (uint8_t)alphabet[Fuzz_Random() % 16U];
+                }
+                break;
+            default:    /* count field */
+                if ((pos + 3U) < len)
+                {
+                    buf[pos + 2U] = (uint8_t)alphabet[Fuzz_Random() % 16U];
+                }
+                break;
+        }
+    }
+
+    return len;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t  buf[FUZZ_MAX_INPUT];
+    unsigned long   iterations = FUZZ_ITERATIONS;
+    unsigned long   i;
+    uint32_t        len;
+    struct timespec t0;
+    struct timespec t1;
+    double          s;
+
+    if (argc >= 2)
+    {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+    if (argc >= 3)
+    {
+        s_rng = strtoull(argv[2], NULL, 0) | 1ULL;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    for (i = 0UL; i < iterations; i++)
+    {
+        len = Fuzz_Generate(buf);
+        (void)LLVMFuzzerTestOneInput(buf, len);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    s = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+
+    printf("%lu inputs in %.2f s, %.0f exec/s\n", iterations, s, (double)iterations / s);
+    printf("  srec ok %llu  ihex ok %llu  queue truncations %llu  stream lines %llu\n",
+           (unsigned long long)s_stats.srec_ok, (unsigned long long)s_stats.ihex_ok,
+           (unsigned long long)s_stats.truncated, (unsigned long long)s_stats.lines);
+
+    return 0;
+}
+#endif /* FUZZ_STANDALONE */